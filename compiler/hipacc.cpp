@@ -44,6 +44,7 @@
 #include <clang/Frontend/TextDiagnosticPrinter.h>
 #include <llvm/Support/Host.h>
 
+#include <fstream>
 #include <sstream>
 
 using namespace clang;
@@ -97,10 +98,27 @@ void printUsage() {
     << "                          Valid values for OpenCL: 'off' and 'Array2D'\n"
     << "  -use-local <o>          Enable/disable usage of shared/local memory in CUDA/OpenCL to stage image pixels to scratchpad\n"
     << "                          Valid values: 'on' and 'off'\n"
-    << "  -vectorize <o>          Enable/disable vectorization of generated CUDA/OpenCL code\n"
+    << "  -vectorize <o>          Enable/disable vectorization of generated CUDA/OpenCL/C++ code\n"
     << "                          Valid values: 'on' and 'off'\n"
     << "  -pixels-per-thread <n>  Specify how many pixels should be calculated per thread\n"
+    << "  -cpu-threads <n>        Specify number of threads for C++ code, 'auto' uses all available cores\n"
+    << "  -cpu-tile <o>           Enable/disable cache blocking of C++ loops for local operators\n"
+    << "                          Valid values: 'auto', 'off', and tile sizes <nxm>, e.g. 256x32\n"
+    << "  -fuse <o>               Enable/disable fusion of point operators into their consumers in C++ code\n"
+    << "                          Valid values: 'on' and 'off'\n"
+    << "  -stream <o>             Enable/disable streaming of C++ kernel pipelines in bands of rows\n"
+    << "                          Valid values: 'on' and 'off'\n"
+    << "  -separable <o>          Enable/disable separation of rank-1 convolution masks in C++ code\n"
+    << "                          Valid values: 'on' and 'off'\n"
+    << "  -concurrent <o>         Enable/disable concurrent execution of independent C++ and OpenCL kernels\n"
+    << "                          Valid values: 'on' and 'off'\n"
+    << "  -tuning-file <file>     Use the C++ kernel configurations from <file>, written by -explore-config\n"
+    << "  -report-intensity <o>   Report operations and bytes per pixel of each kernel and whether it is compute- or memory-bound\n"
+    << "                          Valid values: 'on' for the target device, and peak performance and bandwidth <n:m> in Gop/s and GB/s, e.g. 500:20\n"
     << "  -target-II <n>          Specify target Initiation Interval for Vivado\n"
+    << "  -fpga-lanes <n>         Process local operators in <n> column-parallel lanes for Vivado\n"
+    << "  -share-windows <o>      Enable/disable sharing one line buffer among Vivado local operators reading the same image\n"
+    << "                          Valid values: 'on' and 'off'\n"
     << "  -rs-package <string>    Specify Renderscript package name. (default: \"org.hipacc.rs\")\n"
     << "  -o <file>               Write output to <file>\n"
     << "  --help                  Display available options\n"
@@ -114,6 +132,33 @@ void printVersion() {
 }
 
 
+/// read the configurations of C++ kernels written by the exploration; each
+/// line holds: kernel width height threads tile_x tile_y [time]
+bool readTuningFile(CompilerOptions &compilerOptions) {
+  std::ifstream file(compilerOptions.getTuningFile());
+  if (!file.is_open()) return false;
+
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#') continue;
+
+    std::istringstream iss(line);
+    std::string kernel;
+    CPUConfig config;
+    if (!(iss >> kernel >> config.width >> config.height >> config.threads
+              >> config.tile_x >> config.tile_y) ||
+        config.threads < 0 || config.tile_x <= 0 || config.tile_y <= 0) {
+      llvm::errs() << "Warning: ignoring invalid line in tuning file '"
+                   << compilerOptions.getTuningFile() << "': " << line << "\n";
+      continue;
+    }
+    compilerOptions.addCPUConfig(kernel, config);
+  }
+
+  return true;
+}
+
+
 /// entry to our framework
 int main(int argc, char *argv[]) {
   // first, print the Copyright notice
@@ -253,6 +298,12 @@ int main(int argc, char *argv[]) {
       ++i;
       continue;
     }
+    if (StringRef(argv[i]) == "-tuning-file") {
+      assert(i<(argc-1) && "Mandatory file name for -tuning-file switch missing.");
+      compilerOptions.setTuningFile(argv[i+1]);
+      ++i;
+      continue;
+    }
     if (StringRef(argv[i]) == "-time-kernels") {
       compilerOptions.setTimeKernels(USER_ON);
       continue;
@@ -319,6 +370,116 @@ int main(int argc, char *argv[]) {
       ++i;
       continue;
     }
+    if (StringRef(argv[i]) == "-cpu-threads") {
+      assert(i<(argc-1) && "Mandatory thread count for -cpu-threads switch missing.");
+      if (StringRef(argv[i+1]) == "auto") {
+        compilerOptions.setCPUThreads(0);
+      } else {
+        std::istringstream buffer(argv[i+1]);
+        int val;
+        buffer >> val;
+        if (buffer.fail() || val < 1) {
+          llvm::errs() << "ERROR: Expected positive integer or 'auto' for -cpu-threads switch.\n\n";
+          printUsage();
+          return EXIT_FAILURE;
+        }
+        compilerOptions.setCPUThreads(val);
+      }
+      ++i;
+      continue;
+    }
+    if (StringRef(argv[i]) == "-cpu-tile") {
+      assert(i<(argc-1) && "Mandatory tile specification for -cpu-tile switch missing.");
+      if (StringRef(argv[i+1]) == "off") {
+        compilerOptions.setCPUTiling(USER_OFF);
+      } else if (StringRef(argv[i+1]) == "auto") {
+        compilerOptions.setCPUTiling(ON);
+      } else {
+        int x=0, y=0, ret=0;
+        ret = sscanf(argv[i+1], "%dx%d", &x, &y);
+        if (ret!=2 || x<1 || y<1) {
+          llvm::errs() << "ERROR: Expected valid tile specification for -cpu-tile switch.\n\n";
+          printUsage();
+          return EXIT_FAILURE;
+        }
+        compilerOptions.setCPUTile(x, y);
+      }
+      ++i;
+      continue;
+    }
+    if (StringRef(argv[i]) == "-fuse") {
+      assert(i<(argc-1) && "Mandatory fusion specification for -fuse switch missing.");
+      if (StringRef(argv[i+1]) == "off") {
+        compilerOptions.setFuseKernels(USER_OFF);
+      } else if (StringRef(argv[i+1]) == "on") {
+        compilerOptions.setFuseKernels(USER_ON);
+      } else {
+        llvm::errs() << "ERROR: Expected valid fusion specification for -fuse switch.\n\n";
+        printUsage();
+        return EXIT_FAILURE;
+      }
+      ++i;
+      continue;
+    }
+    if (StringRef(argv[i]) == "-stream") {
+      assert(i<(argc-1) && "Mandatory streaming specification for -stream switch missing.");
+      if (StringRef(argv[i+1]) == "off") {
+        compilerOptions.setStreaming(USER_OFF);
+      } else if (StringRef(argv[i+1]) == "on") {
+        compilerOptions.setStreaming(USER_ON);
+      } else {
+        llvm::errs() << "ERROR: Expected valid streaming specification for -stream switch.\n\n";
+        printUsage();
+        return EXIT_FAILURE;
+      }
+      ++i;
+      continue;
+    }
+    if (StringRef(argv[i]) == "-separable") {
+      assert(i<(argc-1) && "Mandatory separation specification for -separable switch missing.");
+      if (StringRef(argv[i+1]) == "off") {
+        compilerOptions.setSeparateMasks(USER_OFF);
+      } else if (StringRef(argv[i+1]) == "on") {
+        compilerOptions.setSeparateMasks(USER_ON);
+      } else {
+        llvm::errs() << "ERROR: Expected valid separation specification for -separable switch.\n\n";
+        printUsage();
+        return EXIT_FAILURE;
+      }
+      ++i;
+      continue;
+    }
+    if (StringRef(argv[i]) == "-concurrent") {
+      assert(i<(argc-1) && "Mandatory concurrency specification for -concurrent switch missing.");
+      if (StringRef(argv[i+1]) == "off") {
+        compilerOptions.setConcurrentKernels(USER_OFF);
+      } else if (StringRef(argv[i+1]) == "on") {
+        compilerOptions.setConcurrentKernels(USER_ON);
+      } else {
+        llvm::errs() << "ERROR: Expected valid concurrency specification for -concurrent switch.\n\n";
+        printUsage();
+        return EXIT_FAILURE;
+      }
+      ++i;
+      continue;
+    }
+    if (StringRef(argv[i]) == "-report-intensity") {
+      assert(i<(argc-1) && "Mandatory target specification for -report-intensity switch missing.");
+      if (StringRef(argv[i+1]) == "on") {
+        compilerOptions.setReportIntensity(USER_ON);
+      } else {
+        float gops=0, bandwidth=0;
+        int ret = sscanf(argv[i+1], "%f:%f", &gops, &bandwidth);
+        if (ret!=2 || gops<=0 || bandwidth<=0) {
+          llvm::errs() << "ERROR: Expected valid target specification for -report-intensity switch.\n\n";
+          printUsage();
+          return EXIT_FAILURE;
+        }
+        compilerOptions.setPeakPerformance(gops, bandwidth);
+      }
+      ++i;
+      continue;
+    }
     if (StringRef(argv[i]) == "-target-II") {
       assert(i<(argc-1) && "Mandatory target Initiation Interval amount missing.");
       std::istringstream buffer(argv[i+1]);
@@ -333,6 +494,34 @@ int main(int argc, char *argv[]) {
       ++i;
       continue;
     }
+    if (StringRef(argv[i]) == "-fpga-lanes") {
+      assert(i<(argc-1) && "Mandatory lane count for -fpga-lanes switch missing.");
+      std::istringstream buffer(argv[i+1]);
+      int val;
+      buffer >> val;
+      if (buffer.fail() || val < 1) {
+        llvm::errs() << "ERROR: Expected positive integer for -fpga-lanes switch.\n\n";
+        printUsage();
+        return EXIT_FAILURE;
+      }
+      compilerOptions.setFPGALanes(val);
+      ++i;
+      continue;
+    }
+    if (StringRef(argv[i]) == "-share-windows") {
+      assert(i<(argc-1) && "Mandatory specification for -share-windows switch missing.");
+      if (StringRef(argv[i+1]) == "off") {
+        compilerOptions.setShareWindows(USER_OFF);
+      } else if (StringRef(argv[i+1]) == "on") {
+        compilerOptions.setShareWindows(USER_ON);
+      } else {
+        llvm::errs() << "ERROR: Expected valid specification for -share-windows switch.\n\n";
+        printUsage();
+        return EXIT_FAILURE;
+      }
+      ++i;
+      continue;
+    }
     if (StringRef(argv[i]) == "-rs-package") {
       assert(i<(argc-1) && "Mandatory package name string for -rs-package switch missing.");
       compilerOptions.setRSPackageName(argv[i+1]);
@@ -455,6 +644,85 @@ int main(int argc, char *argv[]) {
     }
   }
 
+  // Multi-threading only supported for C/C++ code generation
+  if (compilerOptions.useMultiThreading(USER_ON) && !compilerOptions.emitC99()) {
+    llvm::errs() << "Warning: multi-threaded execution is only supported for C++ code generation!\n"
+                 << "  Multi-threading disabled!\n";
+    compilerOptions.setCPUThreads(1);
+  }
+  // Column-parallel lanes only supported for Vivado code generation
+  if (compilerOptions.getFPGALanes() > 1 && !compilerOptions.emitVivado()) {
+    llvm::errs() << "Warning: column-parallel lanes are only supported for Vivado code generation!\n"
+                 << "  Lanes disabled!\n";
+    compilerOptions.setFPGALanes(1);
+  }
+  // Cache blocking only supported for C/C++ code generation
+  if (compilerOptions.useCPUTiling() && !compilerOptions.emitC99()) {
+    llvm::errs() << "Warning: cache blocking is only supported for C++ code generation!\n"
+                 << "  Cache blocking disabled!\n";
+    compilerOptions.setCPUTiling(USER_OFF);
+  }
+  // Kernel fusion only supported for C/C++ code generation
+  if (compilerOptions.fuseKernels() && !compilerOptions.emitC99()) {
+    llvm::errs() << "Warning: kernel fusion is only supported for C++ code generation!\n"
+                 << "  Kernel fusion disabled!\n";
+    compilerOptions.setFuseKernels(USER_OFF);
+  }
+  // Streaming only supported for C/C++ code generation
+  if (compilerOptions.useStreaming() && !compilerOptions.emitC99()) {
+    llvm::errs() << "Warning: streaming is only supported for C++ code generation!\n"
+                 << "  Streaming disabled!\n";
+    compilerOptions.setStreaming(USER_OFF);
+  }
+  // Separation of masks only supported for C/C++ code generation
+  if (compilerOptions.separateMasks() && !compilerOptions.emitC99()) {
+    llvm::errs() << "Warning: separation of masks is only supported for C++ code generation!\n"
+                 << "  Separation of masks disabled!\n";
+    compilerOptions.setSeparateMasks(USER_OFF);
+  }
+  // Concurrent kernels only supported for C/C++ and OpenCL code generation
+  if (compilerOptions.useConcurrentKernels() && !compilerOptions.emitC99() &&
+      (!compilerOptions.emitOpenCL() || compilerOptions.emitOpenCLFPGA())) {
+    llvm::errs() << "Warning: concurrent kernels are only supported for C++ and OpenCL (ACC, CPU, GPU) code generation!\n"
+                 << "  Concurrent kernels disabled!\n";
+    compilerOptions.setConcurrentKernels(USER_OFF);
+  }
+  // OpenCL kernels launched asynchronously are timed together
+  if (compilerOptions.useConcurrentKernels() && compilerOptions.emitOpenCL() &&
+      (compilerOptions.exploreConfig() || compilerOptions.timeKernels())) {
+    llvm::errs() << "Warning: concurrent OpenCL kernels are not supported in combination with exploration or benchmarking of kernels!\n"
+                 << "  Concurrent kernels disabled!\n";
+    compilerOptions.setConcurrentKernels(USER_OFF);
+  }
+  // Streamed kernels are already interleaved band by band
+  if (compilerOptions.useConcurrentKernels() && compilerOptions.useStreaming()) {
+    llvm::errs() << "Warning: concurrent kernels are not supported in combination with streaming!\n"
+                 << "  Concurrent kernels disabled!\n";
+    compilerOptions.setConcurrentKernels(USER_OFF);
+  }
+  // Tuned configurations only supported for C/C++ code generation
+  if (compilerOptions.useTuningFile() && !compilerOptions.emitC99()) {
+    llvm::errs() << "Warning: tuning files are only supported for C++ code generation!\n"
+                 << "  Tuning file ignored!\n";
+    compilerOptions.setTuningFile(USER_OFF);
+  }
+  // Exploration of C/C++ kernels times each kernel on its own
+  if (compilerOptions.emitC99() && compilerOptions.exploreConfig() &&
+      (compilerOptions.useStreaming() || compilerOptions.useConcurrentKernels())) {
+    llvm::errs() << "Warning: exploration of kernel configurations is not supported in combination with streaming or concurrent kernels!\n"
+                 << "  Exploration disabled!\n";
+    compilerOptions.setExploreConfig(USER_OFF);
+  }
+  // Read tuned configurations, the exploration writes the tuning file
+  if (compilerOptions.useTuningFile() && !compilerOptions.exploreConfig()) {
+    if (!readTuningFile(compilerOptions)) {
+      llvm::errs() << "ERROR: Could not read tuning file '"
+                   << compilerOptions.getTuningFile() << "'!\n\n";
+      printUsage();
+      return EXIT_FAILURE;
+    }
+  }
+
   // print summary of compiler options
   compilerOptions.printSummary(targetDevice.getTargetDeviceName());
 
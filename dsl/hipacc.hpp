@@ -43,6 +43,7 @@ float hipacc_last_timing = 0.0f;
 #include "image.hpp"
 #include "iterationspace.hpp"
 #include "kernel.hpp"
+#include "parallel.hpp"
 #include "mask.hpp"
 #include "pyramid.hpp"
 
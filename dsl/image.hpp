@@ -33,6 +33,7 @@
 
 #include "iterationspace.hpp"
 #include "mask.hpp"
+#include "parallel.hpp"
 
 namespace hipacc {
 
@@ -44,7 +45,8 @@ enum class Boundary : uint8_t {
     CLAMP,
     REPEAT,
     MIRROR,
-    CONSTANT
+    CONSTANT,
+    MIRROR_101
 };
 
 enum class Interpolate : uint8_t {
@@ -149,9 +151,9 @@ class BoundaryCondition {
         Image<data_t> &img;
         const int size_x_, size_y_;
         const Boundary bmode;
-        // dummy reference to return a reference for constants
+        // dummy to return a reference for constants, one per thread
         data_t const_val;
-        data_t &dummy;
+        PerThread<data_t> dummy;
 
     public:
         BoundaryCondition(Image<data_t> &Img, const int size_x, const int size_y, const Boundary bmode) :
@@ -160,7 +162,7 @@ class BoundaryCondition {
             size_y_(size_y),
             bmode(bmode),
             const_val(),
-            dummy(const_val)
+            dummy()
         {
             assert(bmode != Boundary::CONSTANT && "Boundary handling set to Constant, but no Constant specified.");
         }
@@ -171,7 +173,7 @@ class BoundaryCondition {
             size_y_(size),
             bmode(bmode),
             const_val(),
-            dummy(const_val)
+            dummy()
         {
             assert(bmode != Boundary::CONSTANT && "Boundary handling set to Constant, but no Constant specified.");
         }
@@ -182,7 +184,7 @@ class BoundaryCondition {
             size_y_(Mask.size_y()),
             bmode(bmode),
             const_val(),
-            dummy(const_val)
+            dummy()
         {
             assert(bmode != Boundary::CONSTANT && "Boundary handling set to Constant, but no Constant specified.");
         }
@@ -192,8 +194,8 @@ class BoundaryCondition {
             size_x_(size_x),
             size_y_(size_y),
             bmode(bmode),
-            const_val(),
-            dummy(const_val)
+            const_val(val),
+            dummy()
         {
             assert(bmode == Boundary::CONSTANT && "Constant for boundary handling specified, but boundary mode is different.");
         }
@@ -203,8 +205,8 @@ class BoundaryCondition {
             size_x_(size),
             size_y_(size),
             bmode(bmode),
-            const_val(),
-            dummy(const_val)
+            const_val(val),
+            dummy()
         {
             assert(bmode == Boundary::CONSTANT && "Constant for boundary handling specified, but boundary mode is different.");
         }
@@ -214,8 +216,8 @@ class BoundaryCondition {
             size_x_(Mask.size_x()),
             size_y_(Mask.size_y()),
             bmode(bmode),
-            const_val(),
-            dummy(const_val)
+            const_val(val),
+            dummy()
         {
             assert(bmode == Boundary::CONSTANT && "Constant for boundary handling specified, but boundary mode is different.");
         }
@@ -233,6 +235,11 @@ class BoundaryCondition {
             if (idx >= upper) idx = upper - (idx+1 - upper);
             return idx;
         }
+        int mirror_101(int idx, const int lower, const int upper) {
+            if (idx  < lower) idx = lower + (lower - idx);
+            if (idx >= upper) idx = upper - (idx+2 - upper);
+            return idx;
+        }
 
     template<typename> friend class Accessor;
 };
@@ -242,9 +249,8 @@ template<typename data_t>
 class Interpolation {
     protected:
         const Interpolate imode;
-        // dummy reference to return a reference for interpolation
-        data_t interpol_init;
-        data_t &interpol_val;
+        // dummy to return a reference for interpolation, one per thread
+        PerThread<data_t> interpol_val;
 
         virtual data_t &pixel_bh(int x, int y) = 0;
 
@@ -295,7 +301,7 @@ class Interpolation {
 
     public:
         explicit Interpolation(const Interpolate imode) :
-            imode(imode), interpol_init(), interpol_val(interpol_init) {}
+            imode(imode), interpol_val() {}
         Interpolation() : Interpolation(Interpolate::NO) {}
 
         data_t &interpolate(ElementIterator *EI, const int offset_x, const int offset_y, const int width, const int height,
@@ -410,7 +416,8 @@ class AccessorBase {
     protected:
         const int width_, height_;
         const int offset_x_, offset_y_;
-        ElementIterator *EI;
+        // iterator of the thread executing the kernel
+        PerThread<ElementIterator *> EI;
 
         void set_iterator(ElementIterator *ei) { EI = ei; }
 
@@ -437,15 +444,19 @@ class Accessor : public AccessorBase, BoundaryCondition<data_t>, Interpolation<d
         using BoundaryCondition<data_t>::clamp;
         using BoundaryCondition<data_t>::repeat;
         using BoundaryCondition<data_t>::mirror;
+        using BoundaryCondition<data_t>::mirror_101;
         using Interpolation<data_t>::interpolate;
         using Interpolation<data_t>::imode;
 
-        data_t &interpolate(const int x, const int y, const int xf=0, const int yf=0) {
-            return interpolate(EI, offset_x_, offset_y_, width_, height_, x, y, xf, yf);
+        data_t &interpolate(const int xf=0, const int yf=0) {
+            // look up the iterator of this thread only once
+            ElementIterator *ei = EI;
+            assert(ei && "ElementIterator not set!");
+            return interpolate(ei, offset_x_, offset_y_, width_, height_, ei->x(), ei->y(), xf, yf);
         }
 
         virtual data_t &pixel_bh(int x, int y) override {
-            data_t *ret = &dummy;
+            data_t *ret = &dummy.get();
             int lower_x = offset_x_;
             int lower_y = offset_y_;
             int upper_x = offset_x_ + width_;
@@ -470,11 +481,16 @@ class Accessor : public AccessorBase, BoundaryCondition<data_t>, Interpolation<d
                     y = mirror(y, lower_y, upper_y);
                     ret = &img.pixel(x, y);
                     break;
+                case Boundary::MIRROR_101:
+                    x = mirror_101(x, lower_x, upper_x);
+                    y = mirror_101(y, lower_y, upper_y);
+                    ret = &img.pixel(x, y);
+                    break;
                 case Boundary::CONSTANT:
                     if (x < lower_x || x >= upper_x ||
                         y < lower_y || y >= upper_y) {
                         dummy = const_val;
-                        ret = &dummy;
+                        ret = &dummy.get();
                     } else {
                         ret = &img.pixel(x, y);
                     }
@@ -511,18 +527,15 @@ class Accessor : public AccessorBase, BoundaryCondition<data_t>, Interpolation<d
         {}
 
         data_t &operator()() {
-            assert(EI && "ElementIterator not set!");
-            return interpolate(EI->x(), EI->y());
+            return interpolate();
         }
 
         data_t &operator()(const int xf, const int yf) {
-            assert(EI && "ElementIterator not set!");
-            return interpolate(EI->x(), EI->y(), xf, yf);
+            return interpolate(xf, yf);
         }
 
         data_t &operator()(MaskBase &M) {
-            assert(EI && "ElementIterator not set!");
-            return interpolate(EI->x(), EI->y(), M.x(), M.y());
+            return interpolate(M.x(), M.y());
         }
 
 
@@ -64,13 +64,13 @@ class IterationSpaceBase {
                 Coordinate coord;
 
             public:
-                ElementIterator(const int width=0, const int height=0, const int offset_x=0, const int offset_y=0, const IterationSpaceBase *iteration_space=nullptr) :
+                ElementIterator(const int width=0, const int height=0, const int offset_x=0, const int offset_y=0, const IterationSpaceBase *iteration_space=nullptr, const int row=0) :
                     min_x(offset_x),
                     min_y(offset_y),
                     max_x(offset_x+width),
                     max_y(offset_y+height),
-                    iteration_space(iteration_space),
-                    coord(offset_x, offset_y)
+                    iteration_space(row < height ? iteration_space : nullptr),
+                    coord(offset_x, offset_y+row)
                 {}
 
                 // increment so we iterate over elements in a block
@@ -101,6 +101,10 @@ class IterationSpaceBase {
         ElementIterator begin() const {
             return ElementIterator(width_, height_, offset_x_, offset_y_, this);
         }
+        // iterator starting at the given row of the iteration space
+        ElementIterator begin(const int row) const {
+            return ElementIterator(width_, height_, offset_x_, offset_y_, this, row);
+        }
         ElementIterator end() const { return ElementIterator(); }
 
         int width()    const { return width_; }
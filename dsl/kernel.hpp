@@ -28,9 +28,12 @@
 #ifndef __KERNEL_HPP__
 #define __KERNEL_HPP__
 
+#include <algorithm>
+#include <type_traits>
 #include <vector>
 
 #include "iterationspace.hpp"
+#include "parallel.hpp"
 
 namespace hipacc {
 
@@ -53,12 +56,12 @@ class Kernel {
         Accessor<data_t> output_;
         std::vector<AccessorBase *> inputs_;
         data_t reduction_result_;
-        bin_t bin_val_;
-        unsigned int bin_idx_;
+        PerThread<bin_t> bin_val_;
+        PerThread<unsigned int> bin_idx_;
         unsigned int num_bins_;
         bool executed_ = false;
         bool reduced_ = false;
-        bool break_iteration;
+        PerThread<bool> break_iteration;
 
     public:
         explicit Kernel(IterationSpace<data_t> &iteration_space) :
@@ -79,28 +82,44 @@ class Kernel {
 
         void add_accessor(AccessorBase *acc) { inputs_.push_back(acc); }
 
-        void execute() {
-            if (!executed_) {
-                auto end  = iteration_space_.end();
-                auto iter = iteration_space_.begin();
-                // register input & output accessors
+        // apply a function to each pixel of the given rows, each thread
+        // iterates with its own iterator
+        template <typename Function>
+        void iterate_rows(const int row_begin, const int row_end, bool inputs, const Function &fun) {
+            auto end  = iteration_space_.end();
+            auto iter = iteration_space_.begin(row_begin);
+            const int max_y = iteration_space_.offset_y() + row_end;
+
+            // register input & output accessors
+            if (inputs) {
                 for (auto acc : inputs_)
                     acc->set_iterator(&iter);
-                output_.set_iterator(&iter);
+            }
+            output_.set_iterator(&iter);
 
-                // apply kernel for whole iteration space
-                auto start_time = hipacc_time_micro();
-                while (iter != end) {
-                    kernel();
-                    ++iter;
-                }
-                auto end_time = hipacc_time_micro();
-                hipacc_last_timing = (float)(end_time - start_time)/1000.0f;
+            while (iter != end && iter.y() < max_y) {
+                fun();
+                ++iter;
+            }
 
-                // de-register input & output accessors
+            // de-register input & output accessors
+            if (inputs) {
                 for (auto acc : inputs_)
                     acc->set_iterator(nullptr);
-                output_.set_iterator(nullptr);
+            }
+            output_.set_iterator(nullptr);
+        }
+
+        void execute() {
+            if (!executed_) {
+                // apply kernel for whole iteration space, rows in parallel
+                auto start_time = hipacc_time_micro();
+                hipacc_parallel_rows(iteration_space_.height(),
+                        [&] (const int row_begin, const int row_end) {
+                    iterate_rows(row_begin, row_end, true, [&] { kernel(); });
+                });
+                auto end_time = hipacc_time_micro();
+                hipacc_last_timing = (float)(end_time - start_time)/1000.0f;
 
                 executed_ = true;
             }
@@ -111,21 +130,31 @@ class Kernel {
                 execute();
 
             if (!reduced_) {
-                auto end  = iteration_space_.end();
-                auto iter = iteration_space_.begin();
-
-                // register output accessor
-                output_.set_iterator(&iter);
-
-                // first element
-                data_t result = output_();
-
-                // apply reduction for remaining iteration space
-                while (++iter != end)
-                    result = reduce(result, output_());
-
-                // de-register output accessor
-                output_.set_iterator(nullptr);
+                const int height = iteration_space_.height();
+
+                // apply reduction for whole iteration space: reduce() has to
+                // be associative, so integer rows can be reduced in parallel
+                // and combined in order; floating-point reductions keep the
+                // serial order to produce bit-identical results
+                bool parallel = std::is_integral<data_t>::value;
+                std::vector<data_t> row_results(parallel ? height : 1);
+                hipacc_parallel_rows(parallel ? height : 1,
+                        [&] (const int row_begin, const int row_end) {
+                    for (int row=row_begin; row<row_end; ++row) {
+                        int last_row = parallel ? row + 1 : height;
+                        bool first = true;
+                        data_t &result = row_results[row];
+                        iterate_rows(row, last_row, false, [&] {
+                            if (first) result = output_();
+                            else result = reduce(result, output_());
+                            first = false;
+                        });
+                    }
+                });
+
+                data_t result = row_results[0];
+                for (size_t row=1; row<row_results.size(); ++row)
+                    result = reduce(result, row_results[row]);
 
                 reduction_result_ = result;
 
@@ -146,27 +175,30 @@ class Kernel {
 
             num_bins_ = bin_size;
 
-            auto end  = iteration_space_.end();
-            auto iter = iteration_space_.begin();
+            const int width = iteration_space_.width();
+            const int height = iteration_space_.height();
+            std::vector<unsigned int> bin_indices((size_t)width*height);
+            std::vector<bin_t> bin_values((size_t)width*height);
 
-            // register output accessor
-            output_.set_iterator(&iter);
+            // apply binning for whole iteration space, rows in parallel
+            hipacc_parallel_rows(height,
+                    [&] (const int row_begin, const int row_end) {
+                size_t idx = (size_t)row_begin*width;
+                iterate_rows(row_begin, row_end, false, [&] {
+                    binning(x(), y(), output_());
 
-            bin_t *binned_result = new bin_t[bin_size]();
+                    assert(bin_idx_ < bin_size && "Bin index out of range");
 
-            // apply binning for whole iteration space
-            while (iter != end) {
-                binning(x(), y(), output_());
-
-                assert(bin_idx_ < bin_size && "Bin index out of range");
-
-                binned_result[bin_idx_] = reduce(binned_result[bin_idx_], bin_val_);
-
-                ++iter;
-            }
+                    bin_indices[idx] = bin_idx_;
+                    bin_values[idx] = bin_val_;
+                    ++idx;
+                });
+            });
 
-            // de-register output accessor
-            output_.set_iterator(nullptr);
+            // accumulate bins in the order of the pixels
+            bin_t *binned_result = new bin_t[bin_size]();
+            for (size_t idx=0; idx<bin_indices.size(); ++idx)
+                binned_result[bin_indices[idx]] = reduce(binned_result[bin_indices[idx]], bin_values[idx]);
 
             return binned_result;
         }
@@ -190,12 +222,12 @@ class Kernel {
         }
 
         int x() const {
-            assert(output_.EI!=ElementIterator() && "ElementIterator not set!");
+            assert(output_.EI.get() && "ElementIterator not set!");
             return output_.x();
         }
 
         int y() const {
-            assert(output_.EI!=ElementIterator() && "ElementIterator not set!");
+            assert(output_.EI.get() && "ElementIterator not set!");
             return output_.y();
         }
 
@@ -213,29 +245,52 @@ class Kernel {
         void break_iterate() {
           break_iteration = true;
         }
+
+    private:
+        // select the median of all values of the remaining iteration space
+        template <typename Iterator, typename Function>
+        auto median(Iterator &iter, Iterator end, const Function &fun) -> decltype(fun()) {
+            std::vector<decltype(fun())> values;
+            bool &stop = break_iteration.get();
+            while (iter != end && !stop) {
+                values.push_back(fun());
+                ++iter;
+            }
+            auto mid = values.begin() + values.size()/2;
+            std::nth_element(values.begin(), mid, values.end());
+            return *mid;
+        }
 };
 
 
 template <typename data_t, typename bin_t> template <typename data_m, typename Function>
 auto Kernel<data_t, bin_t>::convolve(Mask<data_m> &mask, Reduce mode, const Function& fun) -> decltype(fun()) {
-    break_iteration = false;
+    // flag of this thread, set by break_iterate()
+    bool &stop = break_iteration.get();
+    stop = false;
     auto end  = mask.end();
     auto iter = mask.begin();
 
     // register mask
     mask.set_iterator(&iter);
 
+    if (mode == Reduce::MEDIAN) {
+        auto result = median(iter, end, fun);
+        mask.set_iterator(nullptr);
+        return result;
+    }
+
     // initialize result - calculate first iteration
     auto result = fun();
 
     // advance iterator and apply kernel to remaining iteration space
-    while (++iter != end && !break_iteration) {
+    while (++iter != end && !stop) {
         switch (mode) {
             case Reduce::SUM:    result += fun();                                    break;
             case Reduce::MIN:    result  = hipacc::math::min(fun(), result);         break;
             case Reduce::MAX:    result  = hipacc::math::max(fun(), result);         break;
             case Reduce::PROD:   result *= fun();                                    break;
-            case Reduce::MEDIAN: assert(0 && "Reduce::MEDIAN not implemented yet!"); break;
+            case Reduce::MEDIAN:                                                     break;
         }
     }
 
@@ -248,24 +303,32 @@ auto Kernel<data_t, bin_t>::convolve(Mask<data_m> &mask, Reduce mode, const Func
 
 template <typename data_t, typename bin_t> template <typename Function>
 auto Kernel<data_t, bin_t>::reduce(Domain &domain, Reduce mode, const Function &fun) -> decltype(fun()) {
-    break_iteration = false;
+    // flag of this thread, set by break_iterate()
+    bool &stop = break_iteration.get();
+    stop = false;
     auto end  = domain.end();
     auto iter = domain.begin();
 
     // register domain
     domain.set_iterator(&iter);
 
+    if (mode == Reduce::MEDIAN) {
+        auto result = median(iter, end, fun);
+        domain.set_iterator(nullptr);
+        return result;
+    }
+
     // initialize result - calculate first iteration
     auto result = fun();
 
     // advance iterator and apply kernel to remaining iteration space
-    while (++iter != end && !break_iteration) {
+    while (++iter != end && !stop) {
         switch (mode) {
             case Reduce::SUM:    result += fun();                                    break;
             case Reduce::MIN:    result  = hipacc::math::min(fun(), result);         break;
             case Reduce::MAX:    result  = hipacc::math::max(fun(), result);         break;
             case Reduce::PROD:   result *= fun();                                    break;
-            case Reduce::MEDIAN: assert(0 && "Reduce::MEDIAN not implemented yet!"); break;
+            case Reduce::MEDIAN:                                                     break;
         }
     }
 
@@ -278,7 +341,9 @@ auto Kernel<data_t, bin_t>::reduce(Domain &domain, Reduce mode, const Function &
 
 template <typename data_t, typename bin_t> template <typename Function>
 void Kernel<data_t, bin_t>::iterate(Domain &domain, const Function &fun) {
-    break_iteration = false;
+    // flag of this thread, set by break_iterate()
+    bool &stop = break_iteration.get();
+    stop = false;
     auto end  = domain.end();
     auto iter = domain.begin();
 
@@ -286,7 +351,7 @@ void Kernel<data_t, bin_t>::iterate(Domain &domain, const Function &fun) {
     domain.set_iterator(&iter);
 
     // advance iterator and apply kernel to iteration space
-    while (iter != end && !break_iteration) {
+    while (iter != end && !stop) {
         fun();
         ++iter;
     }
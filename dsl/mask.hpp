@@ -28,6 +28,7 @@
 #define __MASK_HPP__
 
 #include "iterationspace.hpp"
+#include "parallel.hpp"
 #include "types.hpp"
 
 namespace hipacc {
@@ -143,7 +144,8 @@ class Domain : public MaskBase {
         };
 
     protected:
-        DomainIterator *DI;
+        // iterator of the thread executing the kernel
+        PerThread<DomainIterator *> DI;
 
     public:
         Domain(const int size_x, const int size_y) :
@@ -228,7 +230,8 @@ class Domain : public MaskBase {
 template<typename data_t>
 class Mask : public MaskBase {
     private:
-        ElementIterator *EI;
+        // iterator of the thread executing the kernel
+        PerThread<ElementIterator *> EI;
         data_t *array;
 
         template <int size_y, int size_x>
@@ -0,0 +1,112 @@
+//
+// Copyright (c) 2013, University of Erlangen-Nuremberg
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef __PARALLEL_HPP__
+#define __PARALLEL_HPP__
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace hipacc {
+// index of the thread executing a kernel, 0 for the main thread
+thread_local unsigned hipacc_thread_idx = 0;
+
+// number of threads executing the reference implementation, can be set by
+// the environment variable HIPACC_NUM_THREADS
+unsigned hipacc_num_threads() {
+    static unsigned num_threads = [] {
+        unsigned n = std::thread::hardware_concurrency();
+        if (const char *env = std::getenv("HIPACC_NUM_THREADS"))
+            n = std::atoi(env);
+        return std::max(1u, n);
+    }();
+    return num_threads;
+}
+
+
+// state that is written while a pixel is computed, one copy per thread
+template<typename T>
+class PerThread {
+    private:
+        // separate cache lines to avoid false sharing
+        struct Slot {
+            T value;
+            char padding[64 - sizeof(T) % 64];
+        };
+        std::vector<Slot> slots;
+
+    public:
+        PerThread() : slots(hipacc_num_threads()) {
+            for (auto &slot : slots)
+                slot.value = T();
+        }
+        explicit PerThread(const T &value) : slots(hipacc_num_threads()) {
+            for (auto &slot : slots)
+                slot.value = value;
+        }
+
+        T &get() { return slots[hipacc_thread_idx].value; }
+        const T &get() const { return slots[hipacc_thread_idx].value; }
+
+        operator T &() { return get(); }
+        operator const T &() const { return get(); }
+        T &operator->() { return get(); }
+        const T &operator->() const { return get(); }
+        PerThread &operator=(const T &value) {
+            get() = value;
+            return *this;
+        }
+};
+
+
+// process rows [0, rows) in chunks handed out dynamically to the threads
+template<typename Function>
+void hipacc_parallel_rows(const int rows, const Function &fun) {
+    int num_threads = std::max(1, std::min((int)hipacc_num_threads(), rows));
+    int chunk = std::max(1, rows / (8*num_threads));
+    std::atomic<int> next(0);
+
+    auto worker = [&] (unsigned idx) {
+        hipacc_thread_idx = idx;
+        int row;
+        while ((row = next.fetch_add(chunk)) < rows)
+            fun(row, std::min(rows, row + chunk));
+        hipacc_thread_idx = 0;
+    };
+
+    std::vector<std::thread> threads;
+    for (int t=1; t<num_threads; ++t)
+        threads.emplace_back(worker, t);
+    worker(0);
+    for (auto &thread : threads)
+        thread.join();
+}
+} // end namespace hipacc
+
+#endif // __PARALLEL_HPP__
@@ -87,6 +87,7 @@ class ASTTranslate : public StmtVisitor<ASTTranslate, Stmt *> {
     SIMDTypes simdTypes;
     border_variant bh_variant;
     bool emitEstimation;
+    bool emitPixelFunction;
 
     // "global variables"
     unsigned literalCount;
@@ -99,11 +100,25 @@ class ASTTranslate : public StmtVisitor<ASTTranslate, Stmt *> {
     DeclRefExpr *convTmp;
     Reduce convMode;
     int convIdxX, convIdxY;
+    bool convColumn;
+
+    // separable convolutions on CPU: the vertical pass of each row is stored
+    // in a buffer, which is read by the horizontal pass of each pixel
+    struct SeparableConv {
+      CXXMemberCallExpr *call;
+      HipaccMask *mask;
+      LambdaExpr *lambda;
+      VarDecl *buffer;
+    };
+    SmallVector<SeparableConv, 4> sepConvs;
+    Expr *sepLowerX;
+    bool sepRows;
 
     SmallVector<HipaccMask *, 4> redDomains;
     SmallVector<DeclRefExpr *, 4> redTmps;
     SmallVector<Reduce, 4> redModes;
     SmallVector<int, 4> redIdxX, redIdxY;
+    SmallVector<size_t, 4> medianIdx;
     SmallVector<LabelDecl *, 4> breakLabels;
     SmallVector<bool, 4> containsBreak;
 
@@ -111,6 +126,9 @@ class ASTTranslate : public StmtVisitor<ASTTranslate, Stmt *> {
                 *bh_start_bottom, *bh_fall_back;
     DeclRefExpr *outputImage;
     DeclRefExpr *retValRef;
+    // pixel returned by the pixel function of a fused producer
+    DeclRefExpr *fusedPixelRef;
+    HipaccImage *fusedImage;
     Expr *writeImageRHS;
     NamespaceDecl *hipacc_ns, *hipacc_math_ns;
     TypedefDecl *samplerTy;
@@ -310,11 +328,22 @@ class ASTTranslate : public StmtVisitor<ASTTranslate, Stmt *> {
     // Convolution.cpp
     Stmt *getConvolutionStmt(Reduce mode, DeclRefExpr *tmp_var, Expr *ret_val);
     Expr *getInitExpr(Reduce mode, QualType QT);
+    Expr *accessMedianAt(DeclRefExpr *tmp_var, size_t idx);
+    Expr *selectMedian(DeclRefExpr *tmp_var, size_t size, CompoundStmt *CS);
     Stmt *addDomainCheck(HipaccMask *Domain, DeclRefExpr *domain_var, Stmt
         *stmt);
     Stmt *addBreakCheck(DeclRefExpr *break_var, Stmt *stmt);
     bool searchForBreakIterate(Stmt *S);
     Expr *convertConvolution(CXXMemberCallExpr *E);
+    Expr *getCoefficientOperand(Expr *ret_val, HipaccMask *Mask);
+    Expr *getMaskCoefficient(HipaccMask *Mask);
+    bool isZeroCoefficient(Expr *coeff);
+    Expr *foldCoefficient(Expr *coeff, Expr *operand, QualType QT, bool shift);
+    bool isSeparableConvolution(CXXMemberCallExpr *E, SeparableConv &sep);
+    void findSeparableConvolutions(Stmt *S);
+    Expr *accessSeparableBuffer(SeparableConv &sep, Expr *idx_x, int offset);
+    Stmt *createVerticalPass(SeparableConv &sep, Expr *idx_x);
+    Expr *convertSeparableConvolution(SeparableConv &sep);
 
     // Interpolation.cpp
     Expr *addNNInterpolationX(HipaccAccessor *Acc, Expr *idx_x);
@@ -408,6 +437,7 @@ class ASTTranslate : public StmtVisitor<ASTTranslate, Stmt *> {
       simdTypes(SIMDTypes(Ctx, builtins, options)),
       bh_variant(),
       emitEstimation(emitEstimation),
+      emitPixelFunction(false),
       literalCount(0),
       curCStmt(nullptr),
       convMask(nullptr),
@@ -415,6 +445,9 @@ class ASTTranslate : public StmtVisitor<ASTTranslate, Stmt *> {
       convTmp(nullptr),
       convIdxX(0),
       convIdxY(0),
+      convColumn(false),
+      sepLowerX(nullptr),
+      sepRows(false),
       bh_start_left(nullptr),
       bh_start_right(nullptr),
       bh_start_top(nullptr),
@@ -422,6 +455,8 @@ class ASTTranslate : public StmtVisitor<ASTTranslate, Stmt *> {
       bh_fall_back(nullptr),
       outputImage(nullptr),
       retValRef(nullptr),
+      fusedPixelRef(nullptr),
+      fusedImage(nullptr),
       writeImageRHS(nullptr),
       tileVars(),
       lidYRef(nullptr),
@@ -474,6 +509,10 @@ class ASTTranslate : public StmtVisitor<ASTTranslate, Stmt *> {
       bwMap = map;
     }
 
+    // translate the kernel body for a single pixel at gid_x/gid_y without
+    // the surrounding loops, used to fuse the kernel into its consumer
+    void setPixelFunction(bool pixel) { emitPixelFunction = pixel; }
+
   public:
     // dump all available statement visitors
     static void dump_available_statement_visitors() {
@@ -31,6 +31,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <map>
 #include <vector>
 #include <iostream>
 #include <sstream>
@@ -93,6 +94,7 @@ class DependencyTracker : public StmtVisitor<DependencyTracker> {
 
     void VisitDeclStmt(DeclStmt *S);
     void VisitCXXMemberCallExpr(CXXMemberCallExpr *E);
+    void VisitCXXOperatorCallExpr(CXXOperatorCallExpr *E);
 };
 
 
@@ -131,6 +133,13 @@ class HostDataDeps : public ManagedAnalysis {
     unsigned int outId, tmpId;
     std::vector<Node*> schedule;
 
+    // window of a local operator reading a stream shared with other kernels,
+    // operators with the same window share one window generator
+    struct SharedWindow {
+      std::string sizeX, sizeY, border;
+    };
+    std::map<std::string, SharedWindow> sharedWindows_;
+
     // inner class definitions
     class IterationSpace {
       private:
@@ -197,16 +206,26 @@ class HostDataDeps : public ManagedAnalysis {
     class Image {
       private:
         HipaccImage *img;
+        bool hostRead;
 
       public:
         Image(HipaccImage *img)
-            : img(img) {
+            : img(img), hostRead(false) {
         }
 
         std::string getName() {
           return img->getName();
         }
 
+        // pixels are read by host code, e.g. via data() or by assignment
+        bool isHostRead() {
+          return hostRead;
+        }
+
+        void setHostRead() {
+          hostRead = true;
+        }
+
         std::string getTypeStr(size_t ppt) {
           return ASTNode::createVivadoTypeStr(img, ppt);
         }
@@ -380,6 +399,7 @@ class HostDataDeps : public ManagedAnalysis {
     void addAccessor(ValueDecl *AVD, HipaccAccessor *acc, ValueDecl* IVD);
     void addIterationSpace(ValueDecl *ISVD, HipaccIterationSpace *iter, ValueDecl *IVD);
     void runKernel(ValueDecl *VD);
+    void readImage(ValueDecl *VD);
 
     void dump(Process *proc);
     void dump(Space *space);
@@ -392,9 +412,14 @@ class HostDataDeps : public ManagedAnalysis {
     void markSpace(Space *s);
     void createSchedule();
     std::string declareFifo(std::string type, std::string name);
+    std::string printSplitStream(std::string in, std::vector<std::string> out,
+        std::string indent);
+    std::string printStreamCopies(Space *s, std::string indent);
+    // the frame size is passed at runtime, HIPACC_MAX_* only size the buffers
     std::string getEntrySignature(
         std::map<std::string,std::vector<std::pair<std::string,std::string>>> args,
-        bool withTypes=false);
+        bool withTypes=false, std::string width="IS_width",
+        std::string height="IS_height");
     std::string prettyPrint(
         std::map<std::string,std::vector<std::pair<std::string,std::string>>> args,
         bool print=false);
@@ -412,6 +437,10 @@ class HostDataDeps : public ManagedAnalysis {
     bool isStreamForKernel(std::string kernelName, std::string imageName);
     std::string getStreamForKernel(std::string kernelName, std::string imageName);
     std::vector<std::string> getOutputStreamsForKernel(std::string kernelName);
+    // the stream of the image is copied for several kernels
+    bool isSharedStream(std::string kernelName, std::string imageName);
+    void addSharedWindow(std::string kernelName, std::string sizeX,
+        std::string sizeY, std::string border);
     std::string printEntryDecl(
         std::map<std::string,std::vector<std::pair<std::string,std::string>>> args);
     std::string printEntryCall(
@@ -422,6 +451,13 @@ class HostDataDeps : public ManagedAnalysis {
     std::string getInputStream(ValueDecl *VD);
     std::string getOutputStream(ValueDecl *VD);
     std::string getStreamDecl(ValueDecl *VD);
+    // kernel writing an image that is read only by the given kernel
+    ValueDecl *getFusibleProducer(ValueDecl *KVD);
+    // the output image of the kernel is read by host code
+    bool isOutputReadByHost(ValueDecl *KVD);
+    // kernels executed before the given kernel that read or write its images;
+    // false if the kernel is not executed exactly once
+    bool getDependencies(ValueDecl *KVD, std::vector<ValueDecl *> &deps);
 
     static HostDataDeps *parse(ASTContext &Context,
         AnalysisDeclContext &analysisContext,
@@ -79,6 +79,14 @@ class KernelStatistics : public ManagedAnalysis {
     MemoryPattern getMemPattern(const FieldDecl *FD);
     VectorInfo getVectorizeInfo(const VarDecl *VD);
     KernelType getKernelType();
+    // loops with data-dependent trip count or early exits
+    bool hasIrregularWork();
+    // operations and image loads per pixel; those within lambda-functions of
+    // convolve(), reduce(), and iterate() are counted separately (window=true)
+    // since they are executed for each element of the Mask or Domain
+    unsigned getNumOps(bool window=false);
+    unsigned getNumSFUOps(bool window=false);
+    unsigned getNumLoads(const FieldDecl *FD, bool window=false);
 
     ~KernelStatistics() override;
 
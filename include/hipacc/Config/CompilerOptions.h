@@ -39,7 +39,9 @@
 #include <clang/Basic/Version.h>
 #include <llvm/Support/raw_ostream.h>
 
+#include <map>
 #include <string>
+#include <vector>
 
 #if CLANG_VERSION_MAJOR != 6
 #error "Clang Version 6.x required!"
@@ -70,6 +72,14 @@ enum class Language : uint8_t {
   Vivado
 };
 
+// configuration of a C/C++ kernel for an image size, found by the exploration
+// of kernel configurations and read from the tuning file
+struct CPUConfig {
+  int width, height;
+  int threads;
+  int tile_x, tile_y;
+};
+
 class CompilerOptions {
   private:
     // target code and device specification
@@ -86,14 +96,29 @@ class CompilerOptions {
     CompilerOption local_memory;
     CompilerOption multiple_pixels;
     CompilerOption vectorize_kernels;
+    CompilerOption multi_threading;
+    CompilerOption cpu_tiling;
+    CompilerOption fuse_kernels;
+    CompilerOption streaming;
+    CompilerOption separate_masks;
+    CompilerOption concurrent_kernels;
+    CompilerOption tuning_file;
+    CompilerOption report_intensity;
+    CompilerOption share_windows;
     // user defined values for target code features
     int kernel_config_x, kernel_config_y;
     int reduce_config_num_warps, reduce_config_num_hists;
     int align_bytes;
     int pixels_per_thread;
+    int cpu_threads;
+    int cpu_tile_x, cpu_tile_y;
     Texture texture_type;
     std::string rs_package_name, rs_directory;
     int target_ii;
+    int fpga_lanes;
+    std::string tuning_file_name;
+    std::map<std::string, std::vector<CPUConfig>> cpu_configs;
+    float peak_gops, peak_bandwidth;
 
     void getOptionAsString(CompilerOption option, int val=-1) {
       switch (option) {
@@ -129,16 +154,32 @@ class CompilerOptions {
       local_memory(AUTO),
       multiple_pixels(AUTO),
       vectorize_kernels(OFF),
+      multi_threading(OFF),
+      cpu_tiling(OFF),
+      fuse_kernels(OFF),
+      streaming(OFF),
+      separate_masks(OFF),
+      concurrent_kernels(OFF),
+      tuning_file(OFF),
+      report_intensity(OFF),
+      share_windows(ON),
       kernel_config_x(128),
       kernel_config_y(1),
       reduce_config_num_warps(16),
       reduce_config_num_hists(16),
       align_bytes(0),
       pixels_per_thread(1),
+      cpu_threads(1),
+      cpu_tile_x(0),
+      cpu_tile_y(0),
       texture_type(Texture::None),
       rs_package_name("org.hipacc.rs"),
       rs_directory("/data/local/tmp"),
-      target_ii(1)
+      target_ii(1),
+      fpga_lanes(1),
+      tuning_file_name("hipacc_tuning.conf"),
+      peak_gops(0),
+      peak_bandwidth(0)
     {}
 
     bool emitC99() { return target_lang == Language::C99; }
@@ -201,9 +242,59 @@ class CompilerOptions {
       return multiple_pixels & option;
     }
     int getPixelsPerThread() { return pixels_per_thread; }
+    bool useMultiThreading(CompilerOption option=option_ou) {
+      return multi_threading & option;
+    }
+    // number of CPU threads, 0 means all available cores
+    int getCPUThreads() { return cpu_threads; }
+    bool useCPUTiling(CompilerOption option=option_ou) {
+      return cpu_tiling & option;
+    }
+    int getCPUTileX() { return cpu_tile_x; }
+    int getCPUTileY() { return cpu_tile_y; }
+    bool fuseKernels(CompilerOption option=option_ou) {
+      return fuse_kernels & option;
+    }
+    bool useStreaming(CompilerOption option=option_ou) {
+      return streaming & option;
+    }
+    bool separateMasks(CompilerOption option=option_ou) {
+      return separate_masks & option;
+    }
+    bool useConcurrentKernels(CompilerOption option=option_ou) {
+      return concurrent_kernels & option;
+    }
+    // C/C++ kernels take the range of rows to process as parameters
+    bool useRowRanges() {
+      return emitC99() && (useStreaming() || useConcurrentKernels());
+    }
+    bool useTuningFile(CompilerOption option=option_ou) {
+      return tuning_file & option;
+    }
+    std::string getTuningFile() { return tuning_file_name; }
+    // C/C++ kernels take the number of threads and the tile size as parameters
+    bool useCPUConfigParams() {
+      return emitC99() && (exploreConfig() || useTuningFile());
+    }
+    std::vector<CPUConfig> getCPUConfigs(std::string kernel) {
+      auto it = cpu_configs.find(kernel);
+      if (it == cpu_configs.end()) return std::vector<CPUConfig>();
+      return it->second;
+    }
+    bool reportIntensity(CompilerOption option=option_ou) {
+      return report_intensity & option;
+    }
+    bool shareWindows(CompilerOption option=option_ou) {
+      return share_windows & option;
+    }
+    // peak performance (Gop/s) and bandwidth (GB/s) of the target, 0 if not
+    // specified by the user
+    float getPeakGops() { return peak_gops; }
+    float getPeakBandwidth() { return peak_bandwidth; }
     std::string getRSPackageName() { return rs_package_name; }
     std::string getRSDirectory() { return rs_directory; }
     int getTargetII() { return target_ii; }
+    int getFPGALanes() { return fpga_lanes; }
 
     void setTargetLang(Language lang) { target_lang = lang; }
     void setTargetDevice(Device td) { target_device = td; }
@@ -211,6 +302,14 @@ class CompilerOptions {
     void setTimeKernels(CompilerOption o) { time_kernels = o; }
     void setLocalMemory(CompilerOption o) { local_memory = o; }
     void setVectorizeKernels(CompilerOption o) { vectorize_kernels = o; }
+    void setCPUTiling(CompilerOption o) { cpu_tiling = o; }
+    void setFuseKernels(CompilerOption o) { fuse_kernels = o; }
+    void setStreaming(CompilerOption o) { streaming = o; }
+    void setSeparateMasks(CompilerOption o) { separate_masks = o; }
+    void setConcurrentKernels(CompilerOption o) { concurrent_kernels = o; }
+    void setTuningFile(CompilerOption o) { tuning_file = o; }
+    void setShareWindows(CompilerOption o) { share_windows = o; }
+    void setReportIntensity(CompilerOption o) { report_intensity = o; }
 
     void setTextureMemory(Texture type) {
       texture_type = type;
@@ -242,6 +341,18 @@ class CompilerOptions {
       else multiple_pixels = USER_OFF;
     }
 
+    void setCPUThreads(int threads) {
+      cpu_threads = threads;
+      if (threads != 1) multi_threading = USER_ON;
+      else multi_threading = USER_OFF;
+    }
+
+    void setCPUTile(int x, int y) {
+      cpu_tiling = USER_ON;
+      cpu_tile_x = x;
+      cpu_tile_y = y;
+    }
+
     void setRSPackageName(std::string name) {
       rs_package_name = name;
       rs_directory = "/data/data/" + name;
@@ -251,6 +362,25 @@ class CompilerOptions {
       target_ii = ii;
     }
 
+    void setFPGALanes(int lanes) {
+      fpga_lanes = lanes;
+    }
+
+    void setTuningFile(std::string name) {
+      tuning_file = USER_ON;
+      tuning_file_name = name;
+    }
+
+    void addCPUConfig(std::string kernel, CPUConfig config) {
+      cpu_configs[kernel].push_back(config);
+    }
+
+    void setPeakPerformance(float gops, float bandwidth) {
+      report_intensity = USER_ON;
+      peak_gops = gops;
+      peak_bandwidth = bandwidth;
+    }
+
     std::string getTargetPrefix() {
       switch (target_lang) {
         case Language::Vivado:
@@ -317,6 +447,37 @@ class CompilerOptions {
       getOptionAsString(multiple_pixels, pixels_per_thread);
       llvm::errs() << "\n  Vectorization of kernels: ";
       getOptionAsString(vectorize_kernels);
+      llvm::errs() << "\n  Multi-threaded execution on CPU: ";
+      getOptionAsString(multi_threading, cpu_threads);
+      if (useMultiThreading() && cpu_threads == 0) {
+        llvm::errs() << ": all available cores";
+      }
+      llvm::errs() << "\n  Cache blocking of CPU loops: ";
+      getOptionAsString(cpu_tiling);
+      if (useCPUTiling(USER_ON)) {
+        llvm::errs() << ": " << cpu_tile_x << "x" << cpu_tile_y;
+      }
+      llvm::errs() << "\n  Fusion of point operators: ";
+      getOptionAsString(fuse_kernels);
+      llvm::errs() << "\n  Line-buffered streaming of pipelines: ";
+      getOptionAsString(streaming);
+      llvm::errs() << "\n  Separation of rank-1 convolution masks: ";
+      getOptionAsString(separate_masks);
+      llvm::errs() << "\n  Concurrent execution of independent kernels: ";
+      getOptionAsString(concurrent_kernels);
+      llvm::errs() << "\n  Tuned configurations of C/C++ kernels: ";
+      getOptionAsString(tuning_file);
+      if (useTuningFile()) {
+        llvm::errs() << ": " << tuning_file_name;
+      }
+      llvm::errs() << "\n  Report of arithmetic intensity: ";
+      getOptionAsString(report_intensity);
+      if (reportIntensity() && peak_gops > 0) {
+        llvm::errs() << ": " << peak_gops << " Gop/s, " << peak_bandwidth
+                     << " GB/s";
+      }
+      llvm::errs() << "\n  Shared line buffers of Vivado local operators: ";
+      getOptionAsString(share_windows);
       llvm::errs() << "\n\n";
     }
 };
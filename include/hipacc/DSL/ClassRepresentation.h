@@ -64,7 +64,8 @@ enum class Boundary : uint8_t {
   CLAMP,
   REPEAT,
   MIRROR,
-  CONSTANT
+  CONSTANT,
+  MIRROR_101
 };
 
 // reduction modes for convolutions
@@ -293,6 +294,8 @@ class HipaccMask : public HipaccMemory {
     std::string hostMemName;
     bool *domain_space;
     HipaccMask *copy_mask;
+    // rank-1 decomposition of constant masks: mask[y][x] = col[y] * row[x]
+    SmallVector<Expr *, 16> sep_row, sep_col;
 
   public:
     HipaccMask(VarDecl *VD, QualType QT, MaskType type) :
@@ -304,7 +307,9 @@ class HipaccMask : public HipaccMemory {
       kernels(0),
       hostMemName(),
       domain_space(nullptr),
-      copy_mask(nullptr)
+      copy_mask(nullptr),
+      sep_row(0),
+      sep_col(0)
     {}
 
     ~HipaccMask() {
@@ -370,6 +375,10 @@ class HipaccMask : public HipaccMemory {
     HipaccMask *getCopyMask() {
       return copy_mask;
     }
+    void checkSeparable(ASTContext &Ctx);
+    bool isSeparable() { return !sep_row.empty(); }
+    Expr *getRowExpr(size_t x) { return sep_row[x]; }
+    Expr *getColumnExpr(size_t y) { return sep_col[y]; }
 };
 
 
@@ -449,6 +458,9 @@ class HipaccKernelClass {
     KernelType getKernelType() {
       return kernelStatistics->getKernelType();
     }
+    bool hasIrregularWork() {
+      return kernelStatistics->hasIrregularWork();
+    }
 
     void addArg(FieldDecl *FD, QualType QT, StringRef Name) {
       KernelMemberInfo info = { FieldKind::Normal, FD, QT, Name };
@@ -598,9 +610,14 @@ class HipaccKernel : public HipaccKernelFeatures {
     unsigned max_size_x_undef, max_size_y_undef;
     unsigned num_threads_x, num_threads_y;
     unsigned num_reg, num_lmem, num_smem, num_cmem;
+    unsigned cpu_tile_x, cpu_tile_y;
+    std::set<const Stmt *> simd_loops;
+    HipaccKernel *fused_producer, *fused_consumer;
+    bool fused_store;
 
     void calcSizes();
     void calcConfig();
+    void calcCPUTile();
     void createArgInfo();
     void addParam(QualType QT1, QualType QT2, QualType QT3, std::string typeC,
         std::string typeO, std::string name, FieldDecl *fd);
@@ -640,7 +657,12 @@ class HipaccKernel : public HipaccKernelFeatures {
       num_reg(0),
       num_lmem(0),
       num_smem(0),
-      num_cmem(0)
+      num_cmem(0),
+      cpu_tile_x(0),
+      cpu_tile_y(0),
+      fused_producer(nullptr),
+      fused_consumer(nullptr),
+      fused_store(true)
     {
       switch (options.getTargetLang()) {
         default: break;
@@ -786,6 +808,10 @@ class HipaccKernel : public HipaccKernelFeatures {
       }
     }
 
+    // operations and bytes per pixel, and the bound of the kernel on the
+    // target according to the roofline model
+    void printIntensity();
+
     void setNumBinsStr(std::string numBins) {
       binningStrCnt++;
       numBinsStr = numBins;
@@ -811,6 +837,36 @@ class HipaccKernel : public HipaccKernelFeatures {
     unsigned getPixelsPerThreadReduce() {
       return pixels_per_thread[GlobalOperator];
     }
+    unsigned getCPUTileX() {
+      if (!cpu_tile_x) calcCPUTile();
+      return cpu_tile_x;
+    }
+    unsigned getCPUTileY() {
+      if (!cpu_tile_y) calcCPUTile();
+      return cpu_tile_y;
+    }
+    unsigned getCPUVectorWidth();
+    void addSIMDLoop(const Stmt *S) { simd_loops.insert(S); }
+    bool isSIMDLoop(const Stmt *S) { return simd_loops.count(S); }
+
+    // point operator fused into this kernel
+    struct FusedArg {
+      HipaccKernel *K;
+      size_t idx;
+      std::string name;
+    };
+    void setFusedProducer(HipaccKernel *producer) {
+      fused_producer = producer;
+      producer->fused_consumer = this;
+    }
+    HipaccKernel *getFusedProducer() { return fused_producer; }
+    HipaccKernel *getFusedConsumer() { return fused_consumer; }
+    // the pixel function of a fused kernel returns its output pixel instead
+    // of storing it, if the image is read only by the consumer
+    void setFusedStore(bool store) { fused_store = store; }
+    bool getFusedStore() { return fused_store; }
+    std::string getPixelFunctionName() { return kernelName + "_pixel"; }
+    void getFusedArgs(std::string prefix, SmallVectorImpl<FusedArg> &args);
 
     HipaccMask *getLocalWindow() {
       if (maskMap.size() > 0) {
@@ -39,6 +39,10 @@
 
 #include <string>
 
+#ifndef WIN32
+#include <unistd.h>
+#endif
+
 namespace clang {
 namespace hipacc {
 // kernel type categorization
@@ -68,6 +72,7 @@ class HipaccDeviceOptions {
       switch (options.getTargetDevice()) {
         case Device::CPU:
           alignment = 8;
+          vectorization = false;
           break;
         case Device::Fermi_20:
         case Device::Fermi_21:
@@ -207,6 +212,18 @@ class HipaccDevice : public HipaccDeviceOptions {
     unsigned num_alus;
     unsigned num_sfus;
 
+    // CPU only device properties
+    unsigned l2_cache_size;
+    unsigned vector_size;
+
+    // roofline model of the target: peak performance in Gop/s, bandwidth to
+    // memory in GB/s, ALU operations per SFU operation, and for FPGAs the
+    // clock in GHz, at which the pipeline accepts one pixel per II cycles
+    float peak_gops;
+    float peak_bandwidth;
+    unsigned sfu_cost;
+    float fpga_clock;
+
   public:
     explicit HipaccDevice(CompilerOptions &options) :
       HipaccDeviceOptions(options),
@@ -214,10 +231,24 @@ class HipaccDevice : public HipaccDeviceOptions {
       max_threads_per_warp(32),
       max_blocks_per_multiprocessor(8),
       num_alus(0),
-      num_sfus(0)
+      num_sfus(0),
+      l2_cache_size(0),
+      vector_size(0),
+      peak_gops(0),
+      peak_bandwidth(0),
+      sfu_cost(1),
+      fpga_clock(0)
     {
       switch (target_device) {
         case Device::CPU:
+          // assume that the generated code is executed on the host
+          l2_cache_size = 262144;
+          #ifdef _SC_LEVEL2_CACHE_SIZE
+          if (sysconf(_SC_LEVEL2_CACHE_SIZE) > 0)
+            l2_cache_size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+          #endif
+          // bytes per SIMD register, 256 bit (AVX2)
+          vector_size = 32;
           break;
         case Device::Fermi_20:
           max_threads_per_block = 1024;
@@ -316,6 +347,33 @@ class HipaccDevice : public HipaccDeviceOptions {
           num_sfus = 0;
           break;
       }
+
+      if (options.emitVivado() || options.emitOpenCLFPGA()) {
+        // Zynq-7100 (xc7z100) at 333 MHz as used by the samples: one
+        // operation per DSP slice and cycle, 4 64-bit HP ports to DDR
+        fpga_clock = 0.333f;
+        peak_gops = 2020 * fpga_clock;
+        peak_bandwidth = 4.8f;
+        sfu_cost = 4;
+      } else if (target_device == Device::CPU) {
+        // assume that the generated code is executed on the host: one fused
+        // multiply-add per 32-bit SIMD lane and cycle at 2.5 GHz, dual-channel
+        // DDR4
+        unsigned num_cores = 1;
+        #ifdef _SC_NPROCESSORS_ONLN
+        if (sysconf(_SC_NPROCESSORS_ONLN) > 0)
+          num_cores = sysconf(_SC_NPROCESSORS_ONLN);
+        #endif
+        peak_gops = num_cores * (vector_size/4) * 2 * 2.5f;
+        peak_bandwidth = 20.0f;
+        sfu_cost = 10;
+      }
+
+      // target described by the user
+      if (options.getPeakGops() > 0) {
+        peak_gops = options.getPeakGops();
+        peak_bandwidth = options.getPeakBandwidth();
+      }
     }
 
     bool isAMDGPU() {
@@ -58,6 +58,13 @@ class CreateHostStrings {
       if (cur_indent < 0) cur_indent = 0;
       indent = std::string(cur_indent, ' ');
     }
+    void writeCPUKernelCall(HipaccKernel *K, std::string rowLower,
+        std::string rowUpper, std::string &resultStr, std::string config="");
+    void writeCPUKernelLaunch(HipaccKernel *K, std::string &resultStr);
+    unsigned getPixelBytesRead(HipaccKernel *K);
+    std::string getStopTimingStr(std::string name, HipaccAccessor *IS,
+        unsigned bytes_read, unsigned bytes_written);
+    std::string getStopTimingStr(ArrayRef<HipaccKernel *> kernels);
 
   public:
     CreateHostStrings(CompilerOptions &options, HipaccDevice &device) :
@@ -88,7 +95,14 @@ class CreateHostStrings {
         MemoryTransferDirection direction, std::string &resultStr);
     void writeMemoryTransferDomainFromMask(HipaccMask *Domain,
         HipaccMask *Mask, std::string &resultStr);
-    void writeKernelCall(HipaccKernel *K, bool isOutputProcess, std::string &resultStr);
+    void writeKernelCall(HipaccKernel *K, bool isOutputProcess, std::string
+        &resultStr, std::string asyncArgs=std::string());
+    void writeStreamedKernelCalls(ArrayRef<HipaccKernel *> kernels,
+        ArrayRef<unsigned> lags, unsigned rows, std::string &resultStr);
+    void writeConcurrentKernelCalls(ArrayRef<HipaccKernel *> kernels,
+        std::string &resultStr);
+    void writeAsyncKernelCalls(ArrayRef<HipaccKernel *> kernels,
+        ArrayRef<std::vector<unsigned>> deps, std::string &resultStr);
     void writeReduceCall(HipaccKernel *K, std::string &resultStr);
     void writeBinningCall(HipaccKernel *K, std::string &resultStr);
     std::string getInterpolationDefinition(HipaccKernel *K, HipaccAccessor *Acc,
@@ -187,8 +187,6 @@ void ASTTranslate::initCPU(SmallVector<Stmt *, 16> &kernelBody, Stmt *S) {
   DeclContext *DC = FunctionDecl::castToDeclContext(kernelDecl);
   DC->addDecl(gid_x);
   DC->addDecl(gid_y);
-  DeclStmt *gid_x_stmt = createDeclStmt(Ctx, gid_x);
-  DeclStmt *gid_y_stmt = createDeclStmt(Ctx, gid_y);
 
   tileVars.global_id_x = createDeclRefExpr(Ctx, gid_x);
   tileVars.global_id_y = createDeclRefExpr(Ctx, gid_y);
@@ -226,41 +224,419 @@ void ASTTranslate::initCPU(SmallVector<Stmt *, 16> &kernelBody, Stmt *S) {
     VarDecl *output = createVarDecl(Ctx, kernelDecl, "DummyOutputVal",
         Kernel->getIterationSpace()->getImage()->getType());
     retValRef = createDeclRefExpr(Ctx, output);
-  }
-  // convert the function body to kernel syntax
-  Stmt *new_body = Clone(S);
-  assert(isa<CompoundStmt>(new_body) && "CompoundStmt for kernel function body expected!");
 
-  if (compilerOptions.emitVivado()) {
+    // convert the function body to kernel syntax
+    Stmt *new_body = Clone(S);
+    assert(isa<CompoundStmt>(new_body) && "CompoundStmt for kernel function body expected!");
     kernelBody.push_back(new_body);
-  } else {
-    //
-    // for (int gid_y=offset_y; gid_y<is_height+offset_y; gid_y++) {
-    //     for (int gid_x=offset_x; gid_x<is_width+offset_x; gid_x++) {
-    //         body
-    //     }
-    // }
-    //
-    Expr *upper_x = getWidthDecl(Kernel->getIterationSpace());
-    Expr *upper_y = getHeightDecl(Kernel->getIterationSpace());
-    if (Kernel->getIterationSpace()->getOffsetXDecl()) {
-      upper_x = createBinaryOperator(Ctx, upper_x,
-          getOffsetXDecl(Kernel->getIterationSpace()), BO_Add, Ctx.IntTy);
+    return;
+  }
+
+  Expr *lower_x = createIntegerLiteral(Ctx, 0);
+  Expr *lower_y = createIntegerLiteral(Ctx, 0);
+  Expr *upper_x = getWidthDecl(Kernel->getIterationSpace());
+  Expr *upper_y = getHeightDecl(Kernel->getIterationSpace());
+  if (Kernel->getIterationSpace()->getOffsetXDecl()) {
+    lower_x = getOffsetXDecl(Kernel->getIterationSpace());
+    upper_x = createBinaryOperator(Ctx, upper_x,
+        getOffsetXDecl(Kernel->getIterationSpace()), BO_Add, Ctx.IntTy);
+  }
+  if (Kernel->getIterationSpace()->getOffsetYDecl()) {
+    lower_y = getOffsetYDecl(Kernel->getIterationSpace());
+    upper_y = createBinaryOperator(Ctx, upper_y,
+        getOffsetYDecl(Kernel->getIterationSpace()), BO_Add, Ctx.IntTy);
+  }
+
+  // rows of the iteration space processed by this call when streaming or
+  // running kernels concurrently: [offset_y+_stream_lower, offset_y+_stream_upper)
+  Expr *stream_lower = nullptr, *stream_upper = nullptr;
+  if (compilerOptions.useRowRanges()) {
+    stream_lower = createDeclRefExpr(Ctx, createVarDecl(Ctx, kernelDecl,
+          "_stream_lower", Ctx.IntTy));
+    stream_upper = createDeclRefExpr(Ctx, createVarDecl(Ctx, kernelDecl,
+          "_stream_upper", Ctx.IntTy));
+    if (Kernel->getIterationSpace()->getOffsetYDecl()) {
+      stream_lower = createBinaryOperator(Ctx, lower_y, stream_lower, BO_Add,
+          Ctx.IntTy);
+      stream_upper = createBinaryOperator(Ctx, lower_y, stream_upper, BO_Add,
+          Ctx.IntTy);
+    }
+  }
+
+  // for (int idx=lower; idx<upper; idx++) body
+  // for (int idx=lower; idx<upper; idx+=step) body
+  auto create_loop = [&] (VarDecl *idx, Expr *lower, Expr *upper, Expr *step,
+      Stmt *body) -> ForStmt * {
+    if (lower != idx->getInit()) {
+      idx = createVarDecl(Ctx, kernelDecl, idx->getName(), Ctx.IntTy, lower);
+    }
+    DeclRefExpr *idx_ref = createDeclRefExpr(Ctx, idx);
+    Expr *inc = nullptr;
+    if (step) {
+      inc = createBinaryOperator(Ctx, idx_ref, step, BO_AddAssign, Ctx.IntTy);
+    } else {
+      inc = createUnaryOperator(Ctx, idx_ref, UO_PostInc, idx_ref->getType());
+    }
+    return createForStmt(Ctx, createDeclStmt(Ctx, idx),
+        createBinaryOperator(Ctx, idx_ref, upper, BO_LT, Ctx.BoolTy), inc,
+        body);
+  };
+
+  // int name = init;
+  // if (name <cmp> limit) name = limit;
+  auto create_bound = [&] (SmallVector<Stmt *, 16> &body, std::string name,
+      Expr *init, Expr *limit, BinaryOperatorKind cmp) -> DeclRefExpr * {
+    VarDecl *VD = createVarDecl(Ctx, kernelDecl, name, Ctx.IntTy, init);
+    DC->addDecl(VD);
+    DeclRefExpr *VD_ref = createDeclRefExpr(Ctx, VD);
+    body.push_back(createDeclStmt(Ctx, VD));
+    body.push_back(createIfStmt(Ctx, createBinaryOperator(Ctx, VD_ref, limit,
+            cmp, Ctx.BoolTy), createBinaryOperator(Ctx, VD_ref, limit,
+              BO_Assign, Ctx.IntTy), nullptr, nullptr));
+    return VD_ref;
+  };
+
+  // a point operator fused into this kernel computes the pixel read by this
+  // kernel first:
+  // ccProducerKernel_pixel(<producer args>, gid_x, gid_y);
+  // or, if the intermediate image is not stored:
+  // type Producer_pixel = ccProducerKernel_pixel(<producer args>, gid_x, gid_y);
+  Stmt *producer_call = nullptr;
+  if (HipaccKernel *producer = Kernel->getFusedProducer()) {
+    SmallVector<HipaccKernel::FusedArg, 16> fusedArgs;
+    producer->getFusedArgs(producer->getName() + "_", fusedArgs);
+
+    SmallVector<QualType, 16> argTypes;
+    SmallVector<std::string, 16> argNames;
+    SmallVector<Expr *, 16> args;
+    for (auto arg : fusedArgs) {
+      QualType QT = arg.K->getArgTypes()[arg.idx];
+      argTypes.push_back(QT);
+      argNames.push_back(arg.name);
+      args.push_back(createDeclRefExpr(Ctx, createVarDecl(Ctx, kernelDecl,
+              arg.name, QT)));
+    }
+    argTypes.push_back(Ctx.IntTy);
+    argNames.push_back("gid_x");
+    args.push_back(createDeclRefExpr(Ctx, gid_x));
+    argTypes.push_back(Ctx.IntTy);
+    argNames.push_back("gid_y");
+    args.push_back(createDeclRefExpr(Ctx, gid_y));
+
+    QualType pixelTy = producer->getIterationSpace()->getImage()->getType();
+    FunctionDecl *pixelFD = createFunctionDecl(Ctx,
+        Ctx.getTranslationUnitDecl(), producer->getPixelFunctionName(),
+        producer->getFusedStore() ? Ctx.VoidTy : pixelTy, argTypes, argNames);
+    producer_call = createFunctionCall(Ctx, pixelFD, args);
+
+    if (!producer->getFusedStore()) {
+      // accessors to the intermediate image read the returned pixel
+      VarDecl *pixel = createVarDecl(Ctx, kernelDecl, producer->getName() +
+          "_pixel", pixelTy, cast<Expr>(producer_call));
+      DC->addDecl(pixel);
+      producer_call = createDeclStmt(Ctx, pixel);
+      fusedPixelRef = createDeclRefExpr(Ctx, pixel);
+      fusedImage = producer->getIterationSpace()->getImage();
+    }
+  }
+
+  // convert the function body to kernel syntax using the given border
+  // handling variant
+  border_variant bh_all = bh_variant;
+  auto clone_body = [&] (unsigned borders) -> Stmt * {
+    // clear all stored decls before cloning, otherwise existing VarDecls
+    // will be reused and we will miss declarations
+    KernelDeclMap.clear();
+    bh_variant.borderVal = borders;
+    Stmt *new_body = Clone(S);
+    assert(isa<CompoundStmt>(new_body) && "CompoundStmt for kernel function body expected!");
+    bh_variant = bh_all;
+    if (producer_call) {
+      SmallVector<Stmt *, 16> fusedBody;
+      fusedBody.push_back(producer_call);
+      for (auto stmt : cast<CompoundStmt>(new_body)->body())
+        fusedBody.push_back(stmt);
+      new_body = createCompoundStmt(Ctx, fusedBody);
+    }
+    return new_body;
+  };
+
+  if (emitPixelFunction) {
+    // the output pixel is returned instead of being stored
+    VarDecl *output = nullptr;
+    if (!Kernel->getFusedStore()) {
+      output = createVarDecl(Ctx, kernelDecl, "OutputVal",
+          Kernel->getIterationSpace()->getImage()->getType());
+      DC->addDecl(output);
+      kernelBody.push_back(createDeclStmt(Ctx, output));
+      retValRef = createDeclRefExpr(Ctx, output);
+    }
+
+    // gid_x and gid_y are parameters of the pixel function
+    for (auto stmt : cast<CompoundStmt>(clone_body(bh_all.borderVal))->body())
+      kernelBody.push_back(stmt);
+
+    if (output)
+      kernelBody.push_back(createReturnStmt(Ctx, retValRef));
+    return;
+  }
+
+  // the iteration space can only be split into regions if the pixels read
+  // by accessors with border handling map 1:1 to the iteration space
+  bool split_regions = bh_all.borderVal != 0;
+  for (auto img : KernelClass->getImgFields()) {
+    HipaccAccessor *Acc = Kernel->getImgFromMapping(img);
+    if (Acc->getBoundaryMode() != Boundary::UNDEFINED &&
+        Acc->getInterpolationMode() != Interpolate::NO)
+      split_regions = false;
+  }
+
+  // local operators are processed in tiles so that the rows of the accessor
+  // window required by a tile stay resident in the cache; the tile size is a
+  // parameter of the kernel when it is explored or tuned at run time
+  bool tiling = (compilerOptions.useCPUTiling() ||
+                 compilerOptions.useCPUConfigParams()) &&
+                KernelClass->getKernelType() == LocalOperator;
+  Expr *tile_size_x = nullptr, *tile_size_y = nullptr;
+  if (tiling && compilerOptions.useCPUConfigParams()) {
+    tile_size_x = createDeclRefExpr(Ctx, createVarDecl(Ctx, kernelDecl,
+          "_cpu_tile_x", Ctx.IntTy));
+    tile_size_y = createDeclRefExpr(Ctx, createVarDecl(Ctx, kernelDecl,
+          "_cpu_tile_y", Ctx.IntTy));
+  } else if (tiling) {
+    tile_size_x = createIntegerLiteral(Ctx,
+        static_cast<int32_t>(Kernel->getCPUTileX()));
+    tile_size_y = createIntegerLiteral(Ctx,
+        static_cast<int32_t>(Kernel->getCPUTileY()));
+  }
+
+  // separable convolutions: the vertical pass of the current row is stored
+  // for all columns of the iteration space plus the halo of the mask
+  // T _sep<n>[is_width + 2*(size_x/2)];
+  sepConvs.clear();
+  if (compilerOptions.separateMasks()) {
+    findSeparableConvolutions(S);
+    sepLowerX = Kernel->getIterationSpace()->getOffsetXDecl() ? lower_x :
+      nullptr;
+    for (auto &sep : sepConvs) {
+      Expr *size = createBinaryOperator(Ctx,
+          getWidthDecl(Kernel->getIterationSpace()), createIntegerLiteral(Ctx,
+            static_cast<int32_t>(2*(sep.mask->getSizeX()/2))), BO_Add,
+          Ctx.IntTy);
+      QualType QT = Ctx.getVariableArrayType(
+          sep.lambda->getCallOperator()->getReturnType(), size,
+          ArrayType::Normal, 0, SourceRange());
+      sep.buffer = createVarDecl(Ctx, kernelDecl, "_sep" +
+          std::to_string(literalCount++), QT);
+      DC->addDecl(sep.buffer);
     }
+  }
+
+  //
+  // for (int _sep_x=lower_x-size_x/2; _sep_x<upper_x+size_x/2; _sep_x++) {
+  //     vertical pass
+  // }
+  //
+  // the buffer of the vertical pass covers the halo of the mask, hence
+  // border handling is required for left and right in all rows
+  auto create_vertical_passes = [&] (SmallVector<Stmt *, 16> &body,
+      unsigned borders) {
+    border_variant bh_sep;
+    bh_sep.borderVal = borders;
+    bh_sep.borders.left = bh_all.borders.left;
+    bh_sep.borders.right = bh_all.borders.right;
+    bh_variant.borderVal = bh_sep.borderVal;
+    for (auto &sep : sepConvs) {
+      Expr *halo = createIntegerLiteral(Ctx,
+          static_cast<int32_t>(sep.mask->getSizeX()/2));
+      VarDecl *sep_x = createVarDecl(Ctx, kernelDecl, "_sep_x", Ctx.IntTy,
+          createBinaryOperator(Ctx, lower_x, halo, BO_Sub, Ctx.IntTy));
+      body.push_back(createDeclStmt(Ctx, sep.buffer));
+      body.push_back(create_loop(sep_x, sep_x->getInit(),
+            createBinaryOperator(Ctx, upper_x, halo, BO_Add, Ctx.IntTy),
+            nullptr, createVerticalPass(sep, createDeclRefExpr(Ctx, sep_x))));
+    }
+    bh_variant = bh_all;
+  };
+
+  // column regions of a row, each using its own border handling variant
+  struct ColumnRegion {
+    Expr *lower, *upper;
+    unsigned borders;
+  };
+
+  // for (int gid_x=lower; gid_x<upper; gid_x++) body
+  // regions without border handling are marked for explicit vectorization
+  auto create_columns = [&] (Expr *lower, Expr *upper, unsigned borders)
+      -> ForStmt * {
+    ForStmt *loop = create_loop(gid_x, lower, upper, nullptr,
+        clone_body(borders));
+    if (Kernel->vectorize() && borders == 0) Kernel->addSIMDLoop(loop);
+    return loop;
+  };
+
+  //
+  // for (int gid_y=lower_y; gid_y<upper_y; gid_y++) {
+  //     for (int gid_x=region.lower; gid_x<region.upper; gid_x++) {
+  //         body
+  //     }
+  //     ...
+  // }
+  //
+  // or in case of tiling:
+  //
+  // for (int _tile_y=lower_y; _tile_y<upper_y; _tile_y+=tile_size_y) {
+  //     int _tile_y_end = _tile_y + tile_size_y;
+  //     if (_tile_y_end > upper_y) _tile_y_end = upper_y;
+  //     for (int _tile_x=region.lower; _tile_x<region.upper; _tile_x+=tile_size_x) {
+  //         int _tile_x_end = _tile_x + tile_size_x;
+  //         if (_tile_x_end > region.upper) _tile_x_end = region.upper;
+  //         for (int gid_y=_tile_y; gid_y<_tile_y_end; gid_y++) {
+  //             for (int gid_x=_tile_x; gid_x<_tile_x_end; gid_x++) {
+  //                 body
+  //             }
+  //         }
+  //     }
+  //     ...
+  // }
+  //
+  unsigned num_rows = 0;
+  auto create_rows = [&] (Expr *row_lower, Expr *row_upper,
+      ArrayRef<ColumnRegion> regions, bool tiled) -> Stmt * {
+    // clamp the rows to the band processed by this call
+    if (stream_lower) {
+      std::string suffix(std::to_string(num_rows++));
+      row_lower = create_bound(kernelBody, "_row_lower" + suffix, row_lower,
+          stream_lower, BO_LT);
+      row_upper = create_bound(kernelBody, "_row_upper" + suffix, row_upper,
+          stream_upper, BO_GT);
+    }
+
+    SmallVector<Stmt *, 16> rowBody;
+    if (!tiled) {
+      // tiled rows don't provide the vertical pass of separable convolutions
+      if (sepConvs.size()) {
+        unsigned borders = 0;
+        for (auto region : regions)
+          borders |= region.borders;
+        create_vertical_passes(rowBody, borders);
+        sepRows = true;
+      }
+      for (auto region : regions) {
+        rowBody.push_back(create_columns(region.lower, region.upper,
+              region.borders));
+      }
+      sepRows = false;
+      return create_loop(gid_y, row_lower, row_upper, nullptr,
+          rowBody.size()==1 ? rowBody[0] : createCompoundStmt(Ctx, rowBody));
+    }
+
+    VarDecl *tile_y = createVarDecl(Ctx, kernelDecl, "_tile_y", Ctx.IntTy,
+        row_lower);
+    Expr *tile_y_end = create_bound(rowBody, "_tile_y_end",
+        createBinaryOperator(Ctx, createDeclRefExpr(Ctx, tile_y), tile_size_y,
+          BO_Add, Ctx.IntTy), row_upper, BO_GT);
+    for (auto region : regions) {
+      SmallVector<Stmt *, 16> tileBody;
+      VarDecl *tile_x = createVarDecl(Ctx, kernelDecl, "_tile_x", Ctx.IntTy,
+          region.lower);
+      Expr *tile_x_end = create_bound(tileBody, "_tile_x_end",
+          createBinaryOperator(Ctx, createDeclRefExpr(Ctx, tile_x), tile_size_x,
+            BO_Add, Ctx.IntTy), region.upper, BO_GT);
+      tileBody.push_back(create_loop(gid_y, createDeclRefExpr(Ctx, tile_y),
+            tile_y_end, nullptr, create_columns(createDeclRefExpr(Ctx,
+                tile_x), tile_x_end, region.borders)));
+      rowBody.push_back(create_loop(tile_x, region.lower, region.upper,
+            tile_size_x, createCompoundStmt(Ctx, tileBody)));
+    }
+    return create_loop(tile_y, row_lower, row_upper, tile_size_y,
+        createCompoundStmt(Ctx, rowBody));
+  };
+
+  if (!split_regions) {
+    SmallVector<ColumnRegion, 3> regions;
+    regions.push_back({ lower_x, upper_x, bh_all.borderVal });
+    kernelBody.push_back(create_rows(lower_y, upper_y, regions, tiling));
+    return;
+  }
+
+  //
+  // Split the iteration space into regions so that border handling is only
+  // applied where the accessor window exceeds the image:
+  //
+  // int _bh_top = offset_y + max_size_y;
+  // if (_bh_top > is_height+offset_y) _bh_top = is_height+offset_y;
+  // int _bh_bottom = is_height+offset_y - max_size_y;
+  // if (_bh_bottom < _bh_top) _bh_bottom = _bh_top;
+  // (_bh_left and _bh_right accordingly)
+  //
+  // for (gid_y=offset_y; gid_y<_bh_top; gid_y++)               // all borders
+  //   for (gid_x=offset_x; gid_x<is_width+offset_x; gid_x++) body
+  // for (gid_y=_bh_top; gid_y<_bh_bottom; gid_y++) {
+  //   for (gid_x=offset_x; gid_x<_bh_left; gid_x++) body        // left/right
+  //   for (gid_x=_bh_left; gid_x<_bh_right; gid_x++) body       // no borders
+  //   for (gid_x=_bh_right; gid_x<is_width+offset_x; gid_x++) body
+  // }
+  // for (gid_y=_bh_bottom; gid_y<is_height+offset_y; gid_y++)  // all borders
+  //   for (gid_x=offset_x; gid_x<is_width+offset_x; gid_x++) body
+  //
+  // The top and bottom regions keep the checks for all borders, this way
+  // images smaller than the accessor window are handled correctly. Only the
+  // center region is tiled.
+  //
+  Expr *bh_top = lower_y, *bh_bottom = upper_y;
+  if (bh_all.borders.top || bh_all.borders.bottom) {
+    Expr *size_y = createIntegerLiteral(Ctx,
+        static_cast<int32_t>(Kernel->getMaxSizeY()));
+    Expr *init_top = size_y;
     if (Kernel->getIterationSpace()->getOffsetYDecl()) {
-      upper_y = createBinaryOperator(Ctx, upper_y,
-          getOffsetYDecl(Kernel->getIterationSpace()), BO_Add, Ctx.IntTy);
+      init_top = createBinaryOperator(Ctx, lower_y, size_y, BO_Add, Ctx.IntTy);
+    }
+    bh_top = create_bound(kernelBody, "_bh_top", init_top, upper_y, BO_GT);
+    bh_bottom = create_bound(kernelBody, "_bh_bottom",
+        createBinaryOperator(Ctx, upper_y, size_y, BO_Sub, Ctx.IntTy), bh_top,
+        BO_LT);
+  }
+  Expr *bh_left = lower_x, *bh_right = upper_x;
+  if (bh_all.borders.left || bh_all.borders.right) {
+    Expr *size_x = createIntegerLiteral(Ctx,
+        static_cast<int32_t>(Kernel->getMaxSizeX()));
+    Expr *init_left = size_x;
+    if (Kernel->getIterationSpace()->getOffsetXDecl()) {
+      init_left = createBinaryOperator(Ctx, lower_x, size_x, BO_Add, Ctx.IntTy);
     }
-    ForStmt *inner_loop = createForStmt(Ctx, gid_x_stmt, createBinaryOperator(Ctx,
-          tileVars.global_id_x, upper_x, BO_LT, Ctx.BoolTy),
-        createUnaryOperator(Ctx, tileVars.global_id_x, UO_PostInc,
-          tileVars.global_id_x->getType()), new_body);
-    ForStmt *outer_loop = createForStmt(Ctx, gid_y_stmt, createBinaryOperator(Ctx,
-          tileVars.global_id_y, upper_y, BO_LT, Ctx.BoolTy),
-        createUnaryOperator(Ctx, tileVars.global_id_y, UO_PostInc,
-          tileVars.global_id_y->getType()), inner_loop);
+    bh_left = create_bound(kernelBody, "_bh_left", init_left, upper_x, BO_GT);
+    bh_right = create_bound(kernelBody, "_bh_right",
+        createBinaryOperator(Ctx, upper_x, size_x, BO_Sub, Ctx.IntTy), bh_left,
+        BO_LT);
+  }
+
+  border_variant bh_x;
+  bh_x.borders.left = bh_all.borders.left;
+  bh_x.borders.right = bh_all.borders.right;
+
+  SmallVector<ColumnRegion, 3> regions;
+  regions.push_back({ lower_x, upper_x, bh_all.borderVal });
+
+  // top region
+  if (bh_all.borders.top) {
+    kernelBody.push_back(create_rows(lower_y, bh_top, regions, false));
+  }
+
+  // center region: left border, interior, right border
+  SmallVector<ColumnRegion, 3> centerRegions;
+  if (bh_x.borders.left) {
+    centerRegions.push_back({ lower_x, bh_left, bh_x.borderVal });
+  }
+  centerRegions.push_back({ bh_left, bh_right, 0 });
+  if (bh_x.borders.right) {
+    centerRegions.push_back({ bh_right, upper_x, bh_x.borderVal });
+  }
+  kernelBody.push_back(create_rows(bh_top, bh_bottom, centerRegions, tiling));
 
-    kernelBody.push_back(outer_loop);
+  // bottom region
+  if (bh_all.borders.bottom) {
+    kernelBody.push_back(create_rows(bh_bottom, upper_y, regions, false));
   }
 }
 
@@ -1560,8 +1936,32 @@ Stmt *ASTTranslate::VisitCompoundStmtTranslate(CompoundStmt *S) {
 
 Stmt *ASTTranslate::VisitReturnStmtTranslate(ReturnStmt *S) {
   // replace return statements within convolve lambda-functions
-  if (convMask && convTmp)
+  if (convMask && convTmp) {
+    // fold constant coefficients: mask() * expr
+    Expr *operand = nullptr;
+    if (convMask->isConstant() && convMode == Reduce::SUM)
+      operand = getCoefficientOperand(S->getRetValue(), convMask);
+    if (operand) {
+      QualType QT = S->getRetValue()->IgnoreParenImpCasts()->getType();
+      Expr *tap = foldCoefficient(Clone(getMaskCoefficient(convMask)),
+          Clone(operand), QT, true);
+      // drop taps with zero coefficients
+      if (!tap)
+        return nullptr;
+      // re-apply the conversions of the product to the return type
+      SmallVector<ImplicitCastExpr *, 2> casts;
+      Expr *ret_val = S->getRetValue()->IgnoreParens();
+      while (auto ICE = dyn_cast<ImplicitCastExpr>(ret_val)) {
+        casts.push_back(ICE);
+        ret_val = ICE->getSubExpr()->IgnoreParens();
+      }
+      for (auto it = casts.rbegin(); it != casts.rend(); ++it)
+        tap = createImplicitCastExpr(Ctx, (*it)->getType(),
+            (*it)->getCastKind(), tap, nullptr, VK_RValue);
+      return getConvolutionStmt(convMode, convTmp, tap);
+    }
     return getConvolutionStmt(convMode, convTmp, Clone(S->getRetValue()));
+  }
   if (!redDomains.empty() && !redTmps.empty())
     return getConvolutionStmt(redModes.back(), redTmps.back(),
                               Clone(S->getRetValue()));
@@ -2277,8 +2677,12 @@ Expr *ASTTranslate::VisitCXXOperatorCallExprTranslate(CXXOperatorCallExpr *E) {
             "convolution lambda-function.");
         // within convolute lambda-function
         if (mask->isConstant()) {
-          // propagate constants
-          result = Clone(mask->getInitExpr(convIdxX, convIdxY));
+          // propagate constants, the vertical pass of separable convolutions
+          // uses the column vector of the mask
+          if (convColumn)
+            result = Clone(mask->getColumnExpr(convIdxY));
+          else
+            result = Clone(mask->getInitExpr(convIdxX, convIdxY));
         } else {
           // access mask elements
           Expr *midx_x = createIntegerLiteral(Ctx, convIdxX);
@@ -2485,7 +2889,10 @@ Expr *ASTTranslate::VisitCXXOperatorCallExprTranslate(CXXOperatorCallExpr *E) {
         break;
       case 1:
         // 0: -> (this *) Image Class
-        if (use_shared) {
+        if (fusedPixelRef && acc->getImage() == fusedImage) {
+          // pixel computed by the fused producer
+          result = fusedPixelRef;
+        } else if (use_shared) {
           result = accessMemShared(DRE, TX, SY);
         } else {
           result = accessMem(LHS, acc, mem_acc);
@@ -2668,6 +3075,13 @@ Expr *ASTTranslate::VisitCXXMemberCallExprTranslate(CXXMemberCallExpr *E) {
           }
           // fall through
         case Language::C99:
+          // pixel function of a fused kernel returning its output pixel
+          if (emitPixelFunction && retValRef) {
+            result = retValRef;
+            break;
+          }
+          result = accessMem(LHS, acc, mem_acc);
+          break;
         case Language::CUDA:
         case Language::OpenCLACC:
         case Language::OpenCLCPU:
@@ -99,6 +99,29 @@ Stmt *mirror_lower(ASTContext &Ctx, Expr *idx, Expr *lower, Expr *) {
 }
 
 
+// add border handling: MIRROR_101
+Stmt *mirror_101_upper(ASTContext &Ctx, Expr *idx, Expr *upper, Expr *) {
+  // if (idx >= upper) idx = upper - (idx+2 - upper);
+  Expr *bo_upper = createBinaryOperator(Ctx, idx, upper, BO_GE, Ctx.BoolTy);
+
+  return createIfStmt(Ctx, bo_upper, createBinaryOperator(Ctx, idx,
+        createBinaryOperator(Ctx, upper, createParenExpr(Ctx,
+            createBinaryOperator(Ctx, createBinaryOperator(Ctx, idx,
+                createIntegerLiteral(Ctx, 2), BO_Add, Ctx.IntTy),
+              createParenExpr(Ctx, upper), BO_Sub, Ctx.IntTy)) , BO_Sub,
+          Ctx.IntTy), BO_Assign, Ctx.IntTy), nullptr, nullptr);
+}
+Stmt *mirror_101_lower(ASTContext &Ctx, Expr *idx, Expr *lower, Expr *) {
+  // if (idx < lower) idx = lower + (lower - idx);
+  Expr *bo_lower = createBinaryOperator(Ctx, idx, lower, BO_LT, Ctx.BoolTy);
+
+  return createIfStmt(Ctx, bo_lower, createBinaryOperator(Ctx, idx,
+        createBinaryOperator(Ctx, lower, createParenExpr(Ctx,
+            createBinaryOperator(Ctx, lower, idx, BO_Sub, Ctx.IntTy)), BO_Add,
+          Ctx.IntTy), BO_Assign, Ctx.IntTy), nullptr, nullptr);
+}
+
+
 // add border handling: CONSTANT
 Expr *constant_upper(ASTContext &Ctx, Expr *idx, Expr *upper, Expr *cond) {
   // (idx < upper)
@@ -300,6 +323,9 @@ Expr *ASTTranslate::addBorderHandling(DeclRefExpr *LHS, Expr *local_offset_x,
       case Boundary::MIRROR: lower_fun = mirror_lower;
                              upper_fun = mirror_upper;
                              break;
+      case Boundary::MIRROR_101: lower_fun = mirror_101_lower;
+                                 upper_fun = mirror_101_upper;
+                                 break;
       case Boundary::UNDEFINED:
         // in case of exploration boundary handling variants are required
         if (!compilerOptions.exploreConfig()) {
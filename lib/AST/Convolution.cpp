@@ -29,7 +29,8 @@
 //
 //===----------------------------------------------------------------------===//
 
-// includes for numeric_limits
+// includes for min and numeric_limits
+#include <algorithm>
 #include <limits>
 
 #include "hipacc/AST/ASTTranslate.h"
@@ -91,7 +92,11 @@ Stmt *ASTTranslate::getConvolutionStmt(Reduce mode, DeclRefExpr *tmp_var,
       }
       break;
     case Reduce::MEDIAN:
-      assert(0 && "Unsupported reduction mode.");
+      // red[i] = val;
+      result = createBinaryOperator(Ctx, accessMedianAt(tmp_var,
+            medianIdx.back()), ret_val, BO_Assign,
+          Ctx.getAsArrayType(tmp_var->getType())->getElementType());
+      break;
   }
 
   return result;
@@ -104,11 +109,132 @@ template<typename T> T get_init(Reduce mode) {
     case Reduce::MIN:    return std::numeric_limits<T>::max();
     case Reduce::MAX:    return std::numeric_limits<T>::min();
     case Reduce::PROD:   return 1;
-    case Reduce::MEDIAN: assert(false && "Median not yet supported");
+    case Reduce::MEDIAN: assert(false && "Median has no init value");
     default:             assert(false && "Unsupported reduction mode");
   }
 }
 
+// access the array holding the values for the median: red[idx]
+Expr *ASTTranslate::accessMedianAt(DeclRefExpr *tmp_var, size_t idx) {
+  QualType QT = Ctx.getAsArrayType(tmp_var->getType())->getElementType();
+
+  return new (Ctx) ArraySubscriptExpr(createImplicitCastExpr(Ctx,
+        Ctx.getPointerType(QT), CK_ArrayToPointerDecay, tmp_var, nullptr,
+        VK_RValue), createIntegerLiteral(Ctx, static_cast<int32_t>(idx)), QT,
+      VK_LValue, OK_Ordinary, SourceLocation());
+}
+
+
+// select the median of the values stored in red[size]: the comparators of
+// Batcher's odd-even merge sort are pruned to those the median depends on,
+// large windows on CPU use linear-time selection of the runtime instead
+Expr *ASTTranslate::selectMedian(DeclRefExpr *tmp_var, size_t size,
+    CompoundStmt *CS) {
+  QualType QT = Ctx.getAsArrayType(tmp_var->getType())->getElementType();
+  size_t mid = size/2;
+
+  if (compilerOptions.emitC99() && size > 25) {
+    // hipaccMedian(red, size)
+    SmallVector<QualType, 16> argTypes;
+    SmallVector<std::string, 16> argNames;
+    SmallVector<Expr *, 16> args;
+    argTypes.push_back(Ctx.getPointerType(QT));
+    argNames.push_back("data");
+    args.push_back(createImplicitCastExpr(Ctx, Ctx.getPointerType(QT),
+          CK_ArrayToPointerDecay, tmp_var, nullptr, VK_RValue));
+    argTypes.push_back(Ctx.IntTy);
+    argNames.push_back("size");
+    args.push_back(createIntegerLiteral(Ctx, static_cast<int32_t>(size)));
+    FunctionDecl *fun = createFunctionDecl(Ctx, Ctx.getTranslationUnitDecl(),
+        "hipaccMedian", QT, argTypes, argNames);
+    return createFunctionCall(Ctx, fun, args);
+  }
+
+  struct CompareExchange {
+    size_t lo, hi;
+    bool min, max;
+  };
+
+  // sorting network for arbitrary sizes
+  SmallVector<CompareExchange, 128> network;
+  for (size_t p=1; p<size; p+=p) {
+    for (size_t k=p; k>0; k/=2) {
+      for (size_t j=k%p; j+k<size; j+=k+k) {
+        for (size_t i=0; i<std::min(k, size-j-k); ++i) {
+          if ((i+j)/(p+p) == (i+j+k)/(p+p))
+            network.push_back({ i+j, i+j+k, true, true });
+        }
+      }
+    }
+  }
+
+  // keep only the comparator outputs read later on
+  SmallVector<CompareExchange, 128> selection;
+  SmallVector<bool, 128> needed(size, false);
+  needed[mid] = true;
+  for (auto it = network.rbegin(); it != network.rend(); ++it) {
+    bool min = needed[it->lo], max = needed[it->hi];
+    if (!min && !max)
+      continue;
+    selection.push_back({ it->lo, it->hi, min, max });
+    needed[it->lo] = needed[it->hi] = true;
+  }
+
+  FunctionDecl *min_fun = lookup<FunctionDecl>(std::string("min"), QT,
+      hipacc_math_ns);
+  FunctionDecl *max_fun = lookup<FunctionDecl>(std::string("max"), QT,
+      hipacc_math_ns);
+  assert(min_fun && "could not lookup 'min'");
+  assert(max_fun && "could not lookup 'max'");
+  auto compare = [&] (FunctionDecl *fun, size_t lo, size_t hi) -> Expr * {
+    SmallVector<Expr *, 16> funArgs;
+    funArgs.push_back(createImplicitCastExpr(Ctx, QT, CK_LValueToRValue,
+          accessMedianAt(tmp_var, lo), nullptr, VK_RValue));
+    funArgs.push_back(createImplicitCastExpr(Ctx, QT, CK_LValueToRValue,
+          accessMedianAt(tmp_var, hi), nullptr, VK_RValue));
+    return createFunctionCall(Ctx, fun, funArgs);
+  };
+
+  // compare-exchange: _med = min(red[lo], red[hi]);
+  //                   red[hi] = max(red[lo], red[hi]);
+  //                   red[lo] = _med;
+  DeclRefExpr *swap = nullptr;
+  for (auto it = selection.rbegin(); it != selection.rend(); ++it) {
+    if (it->min && it->max) {
+      if (!swap) {
+        VarDecl *swap_decl = createVarDecl(Ctx, kernelDecl, "_med" +
+            std::to_string(literalCount++), QT);
+        DeclContext *DC = FunctionDecl::castToDeclContext(kernelDecl);
+        DC->addDecl(swap_decl);
+        swap = createDeclRefExpr(Ctx, swap_decl);
+        preStmts.push_back(createDeclStmt(Ctx, swap_decl));
+        preCStmt.push_back(CS);
+      }
+      preStmts.push_back(createBinaryOperator(Ctx, swap, compare(min_fun,
+              it->lo, it->hi), BO_Assign, QT));
+      preCStmt.push_back(CS);
+      preStmts.push_back(createBinaryOperator(Ctx, accessMedianAt(tmp_var,
+              it->hi), compare(max_fun, it->lo, it->hi), BO_Assign, QT));
+      preCStmt.push_back(CS);
+      preStmts.push_back(createBinaryOperator(Ctx, accessMedianAt(tmp_var,
+              it->lo), swap, BO_Assign, QT));
+      preCStmt.push_back(CS);
+    } else if (it->min) {
+      preStmts.push_back(createBinaryOperator(Ctx, accessMedianAt(tmp_var,
+              it->lo), compare(min_fun, it->lo, it->hi), BO_Assign, QT));
+      preCStmt.push_back(CS);
+    } else {
+      preStmts.push_back(createBinaryOperator(Ctx, accessMedianAt(tmp_var,
+              it->hi), compare(max_fun, it->lo, it->hi), BO_Assign, QT));
+      preCStmt.push_back(CS);
+    }
+  }
+
+  return createImplicitCastExpr(Ctx, QT, CK_LValueToRValue,
+      accessMedianAt(tmp_var, mid), nullptr, VK_RValue);
+}
+
+
 // create init expression for given aggregation mode and type
 Expr *ASTTranslate::getInitExpr(Reduce mode, QualType QT) {
   Expr *result = nullptr, *initExpr = nullptr;
@@ -286,8 +412,298 @@ bool ASTTranslate::searchForBreakIterate(Stmt *S) {
 }
 
 
+// check if the return value of a convolution lambda-function is the product
+// of the Mask coefficient and another expression: mask() * expr or
+// expr * mask(); returns expr
+Expr *ASTTranslate::getCoefficientOperand(Expr *ret_val, HipaccMask *Mask) {
+  if (ret_val == nullptr)
+    return nullptr;
+
+  BinaryOperator *BO = dyn_cast<BinaryOperator>(ret_val->IgnoreParenImpCasts());
+  if (!BO || BO->getOpcode() != BO_Mul)
+    return nullptr;
+
+  auto is_coefficient = [&] (Expr *E) -> bool {
+    auto call = dyn_cast<CXXOperatorCallExpr>(E->IgnoreParenImpCasts());
+    if (!call || call->getNumArgs() != 1 || !isa<MemberExpr>(call->getArg(0)))
+      return false;
+    auto FD = dyn_cast<FieldDecl>(cast<MemberExpr>(call->getArg(0))->
+        getMemberDecl());
+    return FD && Kernel->getMaskFromMapping(FD) == Mask;
+  };
+
+  if (is_coefficient(BO->getLHS())) return BO->getRHS();
+  if (is_coefficient(BO->getRHS())) return BO->getLHS();
+  return nullptr;
+}
+
+
+// constant Mask coefficient at the current convolution index
+Expr *ASTTranslate::getMaskCoefficient(HipaccMask *Mask) {
+  if (convColumn)
+    return Mask->getColumnExpr(convIdxY);
+  return Mask->getInitExpr(convIdxX, convIdxY);
+}
+
+
+bool ASTTranslate::isZeroCoefficient(Expr *coeff) {
+  Expr::EvalResult val;
+  if (!coeff->EvaluateAsRValue(val, Ctx))
+    return false;
+  if (val.Val.isInt())
+    return val.Val.getInt() == 0;
+  if (val.Val.isFloat())
+    return val.Val.getFloat().isZero();
+  return false;
+}
+
+
+// fold a constant coefficient into its multiplication with operand:
+// 1 and -1 result in the (negated) operand, powers of two in shifts if
+// allowed; returns nullptr for zero coefficients
+Expr *ASTTranslate::foldCoefficient(Expr *coeff, Expr *operand, QualType QT,
+    bool shift) {
+  Expr::EvalResult val;
+  if (coeff->EvaluateAsRValue(val, Ctx)) {
+    if (isZeroCoefficient(coeff))
+      return nullptr;
+
+    // the conversion of operand to the type of the product is implicit and
+    // not printed, e.g. -(x) negates an unsigned x before it is converted to
+    // float; cast the operand explicitly unless it has the product type
+    QualType OT = operand->IgnoreParenImpCasts()->getType();
+    Expr *folded = operand;
+    if (!Ctx.hasSameUnqualifiedType(OT, QT)) {
+      if (OT->isArithmeticType() && QT->isArithmeticType()) {
+        CastKind kind;
+        if (QT->isRealFloatingType())
+          kind = OT->isRealFloatingType() ? CK_FloatingCast :
+                                            CK_IntegralToFloating;
+        else
+          kind = OT->isRealFloatingType() ? CK_FloatingToIntegral :
+                                            CK_IntegralCast;
+        folded = createCStyleCastExpr(Ctx, QT, kind,
+            createParenExpr(Ctx, operand), nullptr,
+            Ctx.getTrivialTypeSourceInfo(QT));
+      } else {
+        folded = nullptr;
+      }
+    }
+
+    Expr *result = nullptr;
+    bool negate = false;
+    if (folded && val.Val.isInt()) {
+      llvm::APSInt ival = val.Val.getInt();
+      negate = ival.isNegative();
+      llvm::APInt aval = negate ? ival.abs() : ival;
+      if (aval == 1) {
+        result = folded;
+      } else if (shift && QT->isUnsignedIntegerType() && aval.isPowerOf2()) {
+        // (operand) << log2(coeff), only for unsigned products since
+        // shifting negative values is undefined
+        result = createBinaryOperator(Ctx, createParenExpr(Ctx, folded),
+            createIntegerLiteral(Ctx, static_cast<int32_t>(aval.logBase2())),
+            BO_Shl, QT);
+      }
+    } else if (folded && val.Val.isFloat()) {
+      llvm::APFloat fval = val.Val.getFloat();
+      negate = fval.isNegative();
+      if (fval.isExactlyValue(1.0) || fval.isExactlyValue(-1.0))
+        result = folded;
+    }
+
+    if (result) {
+      if (negate)
+        result = createUnaryOperator(Ctx, createParenExpr(Ctx, result),
+            UO_Minus, QT);
+      return result;
+    }
+  }
+
+  return createBinaryOperator(Ctx, coeff, operand, BO_Mul, QT);
+}
+
+
+// check if this is a convolution of a separable mask in the form of
+// convolve(mask, Reduce::SUM, [&] () { return mask() * acc(mask); });
+bool ASTTranslate::isSeparableConvolution(CXXMemberCallExpr *E,
+    SeparableConv &sep) {
+  if (!E->getDirectCallee() ||
+      !E->getDirectCallee()->getName().equals("convolve") ||
+      E->getNumArgs() != 3)
+    return false;
+
+  // first parameter: separable Mask
+  MemberExpr *ME = dyn_cast<MemberExpr>(E->getArg(0)->IgnoreImpCasts());
+  FieldDecl *FD = ME ? dyn_cast<FieldDecl>(ME->getMemberDecl()) : nullptr;
+  HipaccMask *Mask = FD ? Kernel->getMaskFromMapping(FD) : nullptr;
+  if (!Mask || Mask->isDomain() || !Mask->isSeparable())
+    return false;
+
+  // second parameter: Reduce::SUM
+  llvm::APSInt mode;
+  if (!E->getArg(1)->EvaluateAsInt(mode, Ctx) ||
+      static_cast<Reduce>(mode.getZExtValue()) != Reduce::SUM)
+    return false;
+
+  // third parameter: lambda-function returning mask() * acc(mask)
+  MaterializeTemporaryExpr *MTE =
+    dyn_cast<MaterializeTemporaryExpr>(E->getArg(2));
+  LambdaExpr *LE = MTE ?
+    dyn_cast<LambdaExpr>(MTE->GetTemporaryExpr()->IgnoreImpCasts()) : nullptr;
+  if (!LE)
+    return false;
+  CompoundStmt *body = dyn_cast<CompoundStmt>(LE->getBody());
+  if (!body || body->size() != 1 || !isa<ReturnStmt>(body->body_front()))
+    return false;
+  Expr *operand = getCoefficientOperand(cast<ReturnStmt>(
+        body->body_front())->getRetValue(), Mask);
+  auto call = operand ?
+    dyn_cast<CXXOperatorCallExpr>(operand->IgnoreParenImpCasts()) : nullptr;
+  if (!call || call->getNumArgs() != 2 || !isa<MemberExpr>(call->getArg(0)))
+    return false;
+  auto AFD = dyn_cast<FieldDecl>(cast<MemberExpr>(call->getArg(0))->
+      getMemberDecl());
+  HipaccAccessor *Acc = AFD ? Kernel->getImgFromMapping(AFD) : nullptr;
+  auto MME = dyn_cast<MemberExpr>(call->getArg(1)->IgnoreImpCasts());
+  if (!Acc || !MME || MME->getMemberDecl() != FD ||
+      Acc->getInterpolationMode() != Interpolate::NO)
+    return false;
+
+  sep.call = E;
+  sep.mask = Mask;
+  sep.lambda = LE;
+  sep.buffer = nullptr;
+
+  return true;
+}
+
+
+// recursively search for separable convolutions through body
+void ASTTranslate::findSeparableConvolutions(Stmt *S) {
+  if (S == nullptr)
+    return;
+
+  if (auto MCE = dyn_cast<CXXMemberCallExpr>(S)) {
+    SeparableConv sep;
+    if (isSeparableConvolution(MCE, sep)) {
+      sepConvs.push_back(sep);
+      return;
+    }
+  }
+
+  for (auto child : S->children())
+    findSeparableConvolutions(child);
+}
+
+
+// access the row buffer of a separable convolution: _sep[idx_x-lower_x+offset]
+Expr *ASTTranslate::accessSeparableBuffer(SeparableConv &sep, Expr *idx_x,
+    int offset) {
+  QualType QT = sep.lambda->getCallOperator()->getReturnType();
+
+  Expr *idx = idx_x;
+  if (sepLowerX)
+    idx = createBinaryOperator(Ctx, idx, sepLowerX, BO_Sub, Ctx.IntTy);
+  if (offset)
+    idx = createBinaryOperator(Ctx, idx, createIntegerLiteral(Ctx, offset),
+        BO_Add, Ctx.IntTy);
+
+  return new (Ctx) ArraySubscriptExpr(createImplicitCastExpr(Ctx,
+        Ctx.getPointerType(QT), CK_ArrayToPointerDecay,
+        createDeclRefExpr(Ctx, sep.buffer), nullptr, VK_RValue), idx, QT,
+      VK_LValue, OK_Ordinary, SourceLocation());
+}
+
+
+// vertical pass of a separable convolution for column idx_x of the current
+// row, the taps are translated like the convolution using the column vector
+// of the mask as coefficients:
+// T _sum = 0;
+// _sum += col[0] * acc(idx_x, gid_y-size_y/2);
+// ...
+// _sep[idx_x-lower_x+size_x/2] = _sum;
+Stmt *ASTTranslate::createVerticalPass(SeparableConv &sep, Expr *idx_x) {
+  QualType QT = sep.lambda->getCallOperator()->getReturnType();
+  SmallVector<Stmt *, 16> body;
+
+  VarDecl *sum_decl = createVarDecl(Ctx, kernelDecl, "_sum" +
+      std::to_string(literalCount++), QT, getInitExpr(Reduce::SUM, QT));
+  DeclContext *DC = FunctionDecl::castToDeclContext(kernelDecl);
+  DC->addDecl(sum_decl);
+  body.push_back(createDeclStmt(Ctx, sum_decl));
+
+  Expr *gid_x = tileVars.global_id_x;
+  tileVars.global_id_x = idx_x;
+  convMask = sep.mask;
+  convMode = Reduce::SUM;
+  convTmp = createDeclRefExpr(Ctx, sum_decl);
+  convColumn = true;
+  convIdxX = sep.mask->getSizeX()/2;
+  for (size_t y=0; y<sep.mask->getSizeY(); ++y) {
+    convIdxY = y;
+    body.push_back(Clone(sep.lambda->getBody()));
+    // clear decls added while cloning last iteration
+    LambdaDeclMap.clear();
+  }
+  tileVars.global_id_x = gid_x;
+  convMask = nullptr;
+  convTmp = nullptr;
+  convColumn = false;
+  convIdxX = convIdxY = 0;
+
+  body.push_back(createBinaryOperator(Ctx, accessSeparableBuffer(sep, idx_x,
+          static_cast<int>(sep.mask->getSizeX()/2)), createDeclRefExpr(Ctx,
+            sum_decl), BO_Assign, QT));
+
+  return createCompoundStmt(Ctx, body);
+}
+
+
+// horizontal pass of a separable convolution, using the row vector of the
+// mask as coefficients:
+// T _tmp = 0;
+// _tmp += row[0] * _sep[gid_x-lower_x+0];
+// ...
+Expr *ASTTranslate::convertSeparableConvolution(SeparableConv &sep) {
+  QualType QT = sep.lambda->getCallOperator()->getReturnType();
+
+  std::string tmp_lit("_tmp" + std::to_string(literalCount++));
+  VarDecl *tmp_decl = createVarDecl(Ctx, kernelDecl, tmp_lit, QT,
+      getInitExpr(Reduce::SUM, QT));
+  DeclContext *DC = FunctionDecl::castToDeclContext(kernelDecl);
+  DC->addDecl(tmp_decl);
+  DeclRefExpr *tmp_dre = createDeclRefExpr(Ctx, tmp_decl);
+
+  CompoundStmt *outerCompountStmt = curCStmt;
+  preStmts.push_back(createDeclStmt(Ctx, tmp_decl));
+  preCStmt.push_back(outerCompountStmt);
+
+  for (size_t x=0; x<sep.mask->getSizeX(); ++x) {
+    Expr *tap = foldCoefficient(Clone(sep.mask->getRowExpr(x)),
+        accessSeparableBuffer(sep, tileVars.global_id_x, static_cast<int>(x)),
+        QT, false);
+    if (!tap)
+      continue;
+    preStmts.push_back(getConvolutionStmt(Reduce::SUM, tmp_dre, tap));
+    preCStmt.push_back(outerCompountStmt);
+  }
+
+  return createImplicitCastExpr(Ctx, QT, CK_LValueToRValue, tmp_dre, nullptr,
+      VK_RValue);
+}
+
+
 // check if we have a convolve/reduce/iterate method and convert it
 Expr *ASTTranslate::convertConvolution(CXXMemberCallExpr *E) {
+  // separable convolution within rows providing the vertical pass
+  if (sepRows) {
+    for (auto &sep : sepConvs) {
+      if (sep.call == E)
+        return convertSeparableConvolution(sep);
+    }
+  }
+
   enum class Method : uint8_t {
     Convolve,
     Reduce,
@@ -417,19 +833,48 @@ Expr *ASTTranslate::convertConvolution(CXXMemberCallExpr *E) {
 
   // init temporary variable depending on aggregation mode
   Expr *init = nullptr;
+  bool median = false;
   switch (method) {
     case Method::Convolve:
-      init = getInitExpr(convMode, LE->getCallOperator()->getReturnType());
+      median = convMode == Reduce::MEDIAN;
+      if (!median)
+        init = getInitExpr(convMode, LE->getCallOperator()->getReturnType());
       break;
     case Method::Reduce:
-      init = getInitExpr(redModes.back(),
-          LE->getCallOperator()->getReturnType());
+      median = redModes.back() == Reduce::MEDIAN;
+      if (!median)
+        init = getInitExpr(redModes.back(),
+            LE->getCallOperator()->getReturnType());
       break;
     case Method::Iterate: break;
   }
+
+  // the median is selected from an array holding all values of the window,
+  // hence the number of values has to be known at compile time
+  QualType tmp_type = LE->getCallOperator()->getReturnType();
+  size_t median_size = 0;
+  if (median) {
+    if ((Mask->isDomain() && !Mask->isConstant()) ||
+        searchForBreakIterate(LE->getBody())) {
+      unsigned DiagIDMedian = Diags.getCustomDiagID(DiagnosticsEngine::Error,
+          "Reduce::MEDIAN requires a constant Domain and does not support "
+          "break_iterate().");
+      Diags.Report(E->getArg(0)->getExprLoc(), DiagIDMedian);
+      exit(EXIT_FAILURE);
+    }
+    for (size_t y=0; y<Mask->getSizeY(); ++y) {
+      for (size_t x=0; x<Mask->getSizeX(); ++x) {
+        if (!Mask->isDomain() || Mask->isDomainDefined(x, y))
+          median_size++;
+      }
+    }
+    tmp_type = Ctx.getConstantArrayType(tmp_type, llvm::APInt(32,
+          median_size), ArrayType::Normal, 0);
+    medianIdx.push_back(0);
+  }
+
   std::string tmp_lit("_tmp" + std::to_string(literalCount++));
-  VarDecl *tmp_decl = createVarDecl(Ctx, kernelDecl, tmp_lit,
-      LE->getCallOperator()->getReturnType(), init);
+  VarDecl *tmp_decl = createVarDecl(Ctx, kernelDecl, tmp_lit, tmp_type, init);
   DeclContext *DC = FunctionDecl::castToDeclContext(kernelDecl);
   DC->addDecl(tmp_decl);
   DeclRefExpr *tmp_dre = createDeclRefExpr(Ctx, tmp_decl);
@@ -471,7 +916,17 @@ Expr *ASTTranslate::convertConvolution(CXXMemberCallExpr *E) {
       break;
   }
 
+  // taps with zero coefficients don't contribute to the sum if the
+  // lambda-function only returns mask() * expr
+  bool zero_taps = method == Method::Convolve && convMode == Reduce::SUM &&
+    Mask->isConstant() && isa<CompoundStmt>(LE->getBody()) &&
+    cast<CompoundStmt>(LE->getBody())->size() == 1 &&
+    isa<ReturnStmt>(cast<CompoundStmt>(LE->getBody())->body_front()) &&
+    getCoefficientOperand(cast<ReturnStmt>(cast<CompoundStmt>(
+          LE->getBody())->body_front())->getRetValue(), Mask);
+
   // unroll Mask/Domain
+  size_t median_tap = 0;
   for (size_t y=0; y<Mask->getSizeY(); ++y) {
     for (size_t x=0; x<Mask->getSizeX(); ++x) {
       bool doIterate = true;
@@ -481,7 +936,16 @@ Expr *ASTTranslate::convertConvolution(CXXMemberCallExpr *E) {
         doIterate = false;
       }
 
+      // drop taps of constant masks with zero coefficients
+      if (zero_taps && isZeroCoefficient(Mask->getInitExpr(x, y))) {
+        doIterate = false;
+      }
+
       if (doIterate) {
+        // all return statements of a tap store to the slot of the tap
+        if (median)
+          medianIdx.back() = median_tap++;
+
         Stmt *iteration = nullptr;
         switch (method) {
           case Method::Convolve:
@@ -543,6 +1007,10 @@ Expr *ASTTranslate::convertConvolution(CXXMemberCallExpr *E) {
   containsBreak.pop_back();
 
   // result of convolution
+  if (median) {
+    medianIdx.pop_back();
+    return selectMedian(tmp_dre, median_size, outerCompountStmt);
+  }
   switch (method) {
     case Method::Convolve:
     case Method::Reduce:
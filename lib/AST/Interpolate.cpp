@@ -117,11 +117,12 @@ FunctionDecl *ASTTranslate::getInterpolationFunction(HipaccAccessor *Acc) {
   // for point, global, and user operators add boundary handling for all borders
   if (KernelClass->getKernelType() != LocalOperator || bh_variant.borderVal) {
     switch (Acc->getBoundaryMode()) {
-      case Boundary::UNDEFINED:                      break;
-      case Boundary::CLAMP:    name += "_clamp_";    break;
-      case Boundary::REPEAT:   name += "_repeat_";   break;
-      case Boundary::MIRROR:   name += "_mirror_";   break;
-      case Boundary::CONSTANT: name += "_constant_"; break;
+      case Boundary::UNDEFINED:                          break;
+      case Boundary::CLAMP:      name += "_clamp_";      break;
+      case Boundary::REPEAT:     name += "_repeat_";     break;
+      case Boundary::MIRROR:     name += "_mirror_";     break;
+      case Boundary::CONSTANT:   name += "_constant_";   break;
+      case Boundary::MIRROR_101: name += "_mirror_101_"; break;
     }
 
     if (Acc->getBoundaryMode() != Boundary::UNDEFINED) {
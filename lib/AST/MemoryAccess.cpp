@@ -240,7 +240,7 @@ Expr *ASTTranslate::accessMemArrAt(DeclRefExpr *LHS, Expr *stride, Expr *idx_x,
   Kernel->setUsed(LHS->getNameInfo().getAsString());
 
   // for vectorization divide stride by vector size
-  if (Kernel->vectorize()) {
+  if (Kernel->vectorize() && !compilerOptions.emitC99()) {
     stride = createBinaryOperator(Ctx, stride, createIntegerLiteral(Ctx, 4),
         BO_Div, Ctx.IntTy);
   }
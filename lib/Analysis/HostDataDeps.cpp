@@ -315,12 +315,33 @@ void DependencyTracker::VisitCXXMemberCallExpr(CXXMemberCallExpr *E) {
                   << std::endl;
           dataDeps.runKernel(DRE->getDecl());
         }
+        if (CRD->getNameAsString() == "Image" &&
+            E->getMethodDecl()->getNameAsString() == "data") {
+          if (DEBUG) std::cout << "  Tracked Image read: "
+                  << DRE->getDecl()->getNameAsString() << std::endl;
+          dataDeps.readImage(DRE->getDecl());
+        }
       }
     }
   }
 }
 
 
+void DependencyTracker::VisitCXXOperatorCallExpr(CXXOperatorCallExpr *E) {
+  // Img = Img; Img = Acc; Acc = Img; Acc = Acc;
+  if (E->getOperator() != OO_Equal || E->getNumArgs() != 2) return;
+
+  if (auto DRE = dyn_cast<DeclRefExpr>(E->getArg(1)->IgnoreParenCasts())) {
+    if (imgDeclMap_.count(DRE->getDecl()) ||
+        accDeclMap_.count(DRE->getDecl())) {
+      if (DEBUG) std::cout << "  Tracked Image read: "
+              << DRE->getDecl()->getNameAsString() << std::endl;
+      dataDeps.readImage(DRE->getDecl());
+    }
+  }
+}
+
+
 void HostDataDeps::addImage(ValueDecl *VD, HipaccImage *img) {
   assert(!imgMap_.count(VD) && "Duplicate Image declaration");
   imgMap_[VD] = new Image(img);
@@ -432,6 +453,15 @@ void HostDataDeps::runKernel(ValueDecl *VD) {
 }
 
 
+void HostDataDeps::readImage(ValueDecl *VD) {
+  if (imgMap_.count(VD)) {
+    imgMap_[VD]->setHostRead();
+  } else if (accMap_.count(VD)) {
+    accMap_[VD]->getImage()->setHostRead();
+  }
+}
+
+
 void HostDataDeps::dump(Process *proc) {
   std::cout << " <- " << proc->getKernel()->getName();
 
@@ -591,7 +621,7 @@ void HostDataDeps::createSchedule() {
 
 std::string HostDataDeps::getEntrySignature(
     std::map<std::string,std::vector<std::pair<std::string,std::string>>> args,
-    bool withTypes) {
+    bool withTypes, std::string width, std::string height) {
   std::ostringstream retVal;
   if (withTypes) {
     retVal << "void ";
@@ -628,6 +658,12 @@ std::string HostDataDeps::getEntrySignature(
     }
   }
 
+  if (withTypes) {
+    retVal << ", int IS_width, int IS_height";
+  } else {
+    retVal << ", " << width << ", " << height;
+  }
+
   retVal << ")";
 
   return retVal.str();
@@ -653,6 +689,110 @@ std::string HostDataDeps::declareFifo(std::string type, std::string name) {
   return retVal.str();
 }
 
+std::string HostDataDeps::printSplitStream(std::string in,
+    std::vector<std::string> out, std::string indent) {
+  std::ostringstream retVal;
+
+  retVal << indent << "splitStream";
+  if (out.size() > 2) {
+    retVal << out.size();
+  }
+  if (compilerOptions.getPixelsPerThread() > 1) {
+    retVal << "VECT";
+  }
+  retVal << "<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT,HIPACC_WINDOW_SIZE_X,HIPACC_WINDOW_SIZE_Y";
+  if (compilerOptions.getPixelsPerThread() > 1) {
+    retVal << ",HIPACC_PPT";
+  }
+  retVal << ">(" << in;
+  for (auto it = out.begin(); it != out.end(); ++it) {
+    retVal << ", " << *it;
+  }
+  retVal << ", IS_width, IS_height);" << std::endl;
+
+  return retVal.str();
+}
+
+std::string HostDataDeps::printStreamCopies(Space *s, std::string indent) {
+  std::ostringstream decls, calls;
+
+  // group local operators with equal windows, each group gets its own window
+  // generator, all other kernels get a copy of the pixel stream
+  std::vector<SharedWindow> windows;
+  std::vector<std::vector<std::string>> groups;
+  std::vector<std::string> pixelStreams;
+  std::vector<Process*> procs = s->getDstProcesses();
+  for (auto it = procs.begin(); it != procs.end(); ++it) {
+    Process *t = *it;
+    std::string stream;
+    for (auto it2 = t->inStreams.begin(); it2 != t->inStreams.end(); ++it2) {
+      if (findVector(s->cpyStreams, *it2)) {
+        stream = *it2;
+        break;
+      }
+    }
+    if (!sharedWindows_.count(t->getKernel()->getName())) {
+      decls << indent << declareFifo(getTypeStr(s), stream);
+      pixelStreams.push_back(stream);
+      continue;
+    }
+
+    SharedWindow &win = sharedWindows_[t->getKernel()->getName()];
+    std::string typeStr = "StreamWindow<" + win.sizeX + "," + win.sizeY +
+                          "," + getTypeStr(s) + " >";
+    decls << indent << declareFifo(typeStr, stream);
+    decls << "#pragma HLS data_pack variable=" << stream << std::endl;
+
+    size_t i = 0;
+    for (; i < windows.size(); ++i) {
+      if (windows[i].sizeX == win.sizeX && windows[i].sizeY == win.sizeY &&
+          windows[i].border == win.border) {
+        break;
+      }
+    }
+    if (i == windows.size()) {
+      windows.push_back(win);
+      groups.push_back(std::vector<std::string>());
+    }
+    groups[i].push_back(stream);
+  }
+
+  bool copyPixels = pixelStreams.size() + windows.size() > 1;
+  for (size_t i = 0; i < windows.size(); ++i) {
+    std::string typeStr = "StreamWindow<" + windows[i].sizeX + "," +
+                          windows[i].sizeY + "," + getTypeStr(s) + " >";
+
+    std::string in = s->stream;
+    if (copyPixels) {
+      in = createStream(s);
+      decls << indent << declareFifo(getTypeStr(s), in);
+      pixelStreams.push_back(in);
+    }
+
+    std::string out = groups[i].front();
+    if (groups[i].size() > 1) {
+      out = createStream(s);
+      decls << indent << declareFifo(typeStr, out);
+      decls << "#pragma HLS data_pack variable=" << out << std::endl;
+    }
+
+    calls << indent << "generateWindows<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT,"
+          << windows[i].sizeX << "," << windows[i].sizeY << ">(" << in << ", "
+          << out << ", IS_width, IS_height" << windows[i].border
+          << ");" << std::endl;
+    if (groups[i].size() > 1) {
+      calls << printSplitStream(out, groups[i], indent);
+    }
+  }
+
+  if (copyPixels) {
+    return decls.str() + printSplitStream(s->stream, pixelStreams, indent) +
+           calls.str();
+  }
+
+  return decls.str() + calls.str();
+}
+
 std::string HostDataDeps::printFifoDecls(std::string indent) {
   std::ostringstream retVal;
 
@@ -778,6 +918,28 @@ std::vector<std::string> HostDataDeps::getOutputStreamsForKernel(
   return retVal;
 }
 
+bool HostDataDeps::isSharedStream(std::string kernelName,
+                                  std::string imageName) {
+  for (auto it = processes_.begin(); it != processes_.end(); ++it) {
+    Process *t = *it;
+    if (kernelName.compare(t->getKernel()->getName()) == 0) {
+      std::vector<Space*> spaces = t->getInSpaces();
+      for (auto it2 = spaces.begin(); it2 != spaces.end(); ++it2) {
+        if (imageName.compare((*it2)->getImage()->getName()) == 0) {
+          return (*it2)->getDstProcesses().size() > 1;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+void HostDataDeps::addSharedWindow(std::string kernelName, std::string sizeX,
+                                   std::string sizeY, std::string border) {
+  sharedWindows_[kernelName] = { sizeX, sizeY, border };
+}
+
 std::string HostDataDeps::prettyPrint(
     std::map<std::string,std::vector<std::pair<std::string,std::string>>> args,
     bool print) {
@@ -795,31 +957,15 @@ std::string HostDataDeps::prettyPrint(
       Space *s = (Space*)*it;
       size_t nCpyStreams = s->cpyStreams.size();
       if (nCpyStreams > 0) {
-        for (auto it2 = s->cpyStreams.begin();
-                  it2 != s->cpyStreams.end(); ++it2) {
-          retVal << indent << declareFifo(getTypeStr(s), *it2);
-        }
 #define NICO_LIB
 #ifdef NICO_LIB
-        retVal << indent << "splitStream";
-        if (nCpyStreams > 2) {
-          retVal << nCpyStreams;
-        }
-        if (compilerOptions.getPixelsPerThread() > 1) {
-          retVal << "VECT";
-        }
-        retVal << "<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT,HIPACC_WINDOW_SIZE_X,HIPACC_WINDOW_SIZE_Y";
-        if (compilerOptions.getPixelsPerThread() > 1) {
-          retVal << ",HIPACC_PPT";
-        }
-        retVal << ">(" << s->stream;
+        retVal << printStreamCopies(s, indent);
+#else // NICO_LIB
         for (auto it2 = s->cpyStreams.begin();
                   it2 != s->cpyStreams.end(); ++it2) {
-          retVal << ", " << *it2;
+          retVal << indent << declareFifo(getTypeStr(s), *it2);
         }
-        retVal << ", HIPACC_MAX_WIDTH, HIPACC_MAX_HEIGHT);" << std::endl;
-#else // NICO_LIB
-        retVal << indent << "for (int i = 0; i < HIPACC_MAX_WIDTH*HIPACC_MAX_HEIGHT; ++i) {"
+        retVal << indent << "for (int i = 0; i < IS_width*IS_height; ++i) {"
                << std::endl;
         retVal << indent << indent << getTypeStr(s) << " val;"
                << std::endl;
@@ -867,7 +1013,7 @@ std::string HostDataDeps::prettyPrint(
           retVal << ", " << it2->second;
         }
       }
-      retVal << ", HIPACC_MAX_WIDTH, HIPACC_MAX_HEIGHT);" << std::endl;
+      retVal << ", IS_width, IS_height);" << std::endl;
     }
   }
 
@@ -884,14 +1030,59 @@ std::string HostDataDeps::prettyPrint(
 
 std::string HostDataDeps::printEntryDecl(
     std::map<std::string,std::vector<std::pair<std::string,std::string>>> args) {
-  return getEntrySignature(args, true) + ";\n";
+  std::ostringstream retVal;
+  retVal << getEntrySignature(args, true) << ";" << std::endl;
+
+  // streams of one frame, replicated per slot by HipaccPipeline
+  std::vector<Space*> spaces = getOutputSpaces();
+  std::vector<Space*> in = getInputSpaces();
+  spaces.insert(spaces.end(), in.begin(), in.end());
+
+  retVal << std::endl << "struct HipaccRunStreams {" << std::endl;
+  for (auto it = spaces.begin(); it != spaces.end(); ++it) {
+    retVal << "  hls::stream<" << getTypeStr(*it) << " > " << (*it)->stream
+           << ";" << std::endl;
+  }
+  retVal << "};" << std::endl;
+
+  retVal << "inline void hipaccRun(HipaccRunStreams &streams";
+  for (auto it = args.begin(); it != args.end(); ++it) {
+    for (auto it2 = it->second.begin(); it2 != it->second.end(); ++it2) {
+      retVal << ", " << it2->first << " " << it2->second;
+    }
+  }
+  retVal << ", int IS_width, int IS_height) {" << std::endl << "  hipaccRun(";
+  for (auto it = spaces.begin(); it != spaces.end(); ++it) {
+    if (it != spaces.begin()) {
+      retVal << ", ";
+    }
+    retVal << "streams." << (*it)->stream;
+  }
+  for (auto it = args.begin(); it != args.end(); ++it) {
+    for (auto it2 = it->second.begin(); it2 != it->second.end(); ++it2) {
+      retVal << ", " << it2->second;
+    }
+  }
+  retVal << ", IS_width, IS_height);" << std::endl << "}" << std::endl;
+
+  return retVal.str();
 }
 
 
 std::string HostDataDeps::printEntryCall(
     std::map<std::string,std::vector<std::pair<std::string,std::string>>> args,
     std::string img) {
-  return getEntrySignature(args) + ";\n";
+  // all images of the dataflow region have the size of the image read back,
+  // vectorized streams are padded to a multiple of the pixels per thread
+  std::ostringstream width;
+  size_t ppt = compilerOptions.getPixelsPerThread();
+  if (ppt > 1) {
+    width << "((" << img << "->width+" << ppt-1 << ")/" << ppt << "*" << ppt
+          << ")";
+  } else {
+    width << img << "->width";
+  }
+  return getEntrySignature(args, false, width.str(), img + "->height") + ";\n";
 }
 
 
@@ -956,6 +1147,96 @@ std::string HostDataDeps::getStreamDecl(ValueDecl *VD) {
 }
 
 
+ValueDecl *HostDataDeps::getFusibleProducer(ValueDecl *KVD) {
+  if (!kernelMap_.count(KVD)) return nullptr;
+
+  // returns the only process executing the given kernel
+  auto get_process = [&] (Kernel *kernel) -> Process * {
+    Process *proc = nullptr;
+    for (auto it = processes_.begin(); it != processes_.end(); ++it) {
+      if ((*it)->getKernel() == kernel) {
+        if (proc != nullptr) return nullptr;
+        proc = *it;
+      }
+    }
+    return proc;
+  };
+
+  Process *proc = get_process(kernelMap_[KVD]);
+  if (proc == nullptr) return nullptr;
+
+  // look for a single input space written by another process, which is read
+  // exclusively by this process
+  Process *src = nullptr;
+  std::vector<Space*> spaces = proc->getInSpaces();
+  for (auto it = spaces.begin(); it != spaces.end(); ++it) {
+    Process *p = (*it)->getSrcProcess();
+    if (p == nullptr || (*it)->getDstProcesses().size() != 1) continue;
+    // only a single producer can be fused
+    if (src != nullptr) return nullptr;
+    src = p;
+  }
+  if (src == nullptr || get_process(src->getKernel()) != src) return nullptr;
+
+  for (auto it = kernelMap_.begin(); it != kernelMap_.end(); ++it) {
+    if (it->second == src->getKernel()) return it->first;
+  }
+
+  return nullptr;
+}
+
+
+bool HostDataDeps::isOutputReadByHost(ValueDecl *KVD) {
+  if (!kernelMap_.count(KVD)) return true;
+
+  return kernelMap_[KVD]->getIterationSpace()->getImage()->isHostRead();
+}
+
+
+bool HostDataDeps::getDependencies(ValueDecl *KVD,
+    std::vector<ValueDecl *> &deps) {
+  if (!kernelMap_.count(KVD)) return false;
+
+  Process *proc = nullptr;
+  for (auto it = processes_.begin(); it != processes_.end(); ++it) {
+    if ((*it)->getKernel() == kernelMap_[KVD]) {
+      if (proc != nullptr) return false;
+      proc = *it;
+    }
+  }
+  if (proc == nullptr) return false;
+
+  // read after write: processes writing the input spaces
+  std::vector<Process*> procs;
+  std::vector<Space*> spaces = proc->getInSpaces();
+  for (auto it = spaces.begin(); it != spaces.end(); ++it) {
+    if ((*it)->getSrcProcess() != nullptr)
+      procs.push_back((*it)->getSrcProcess());
+  }
+
+  // write after write and write after read: processes writing or reading
+  // previous spaces of the output image
+  Space *out = proc->getOutSpace();
+  for (auto it = spaces_.begin(); it != spaces_.end() && *it != out; ++it) {
+    if ((*it)->getImage() != out->getImage()) continue;
+    if ((*it)->getSrcProcess() != nullptr)
+      procs.push_back((*it)->getSrcProcess());
+    std::vector<Process*> dst = (*it)->getDstProcesses();
+    procs.insert(procs.end(), dst.begin(), dst.end());
+  }
+
+  for (auto it = procs.begin(); it != procs.end(); ++it) {
+    if (*it == proc) continue;
+    for (auto it2 = kernelMap_.begin(); it2 != kernelMap_.end(); ++it2) {
+      if (it2->second == (*it)->getKernel() && !findVector(deps, it2->first))
+        deps.push_back(it2->first);
+    }
+  }
+
+  return true;
+}
+
+
 const bool HostDataDeps::DEBUG =
 #ifdef PRINT_DEBUG
     true;
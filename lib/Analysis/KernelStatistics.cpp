@@ -39,6 +39,7 @@
 
 #include <clang/Analysis/Analyses/PostOrderCFGView.h>
 #include <clang/AST/ASTContext.h>
+#include <clang/AST/ParentMap.h>
 #include <clang/AST/StmtVisitor.h>
 
 //#define DEBUG_ANALYSIS
@@ -57,6 +58,7 @@ class KernelStatsImpl {
     llvm::DenseMap<const FieldDecl *, MemoryAccess> memToAccess;
     llvm::DenseMap<const FieldDecl *, MemoryPattern> memToPattern;
     llvm::DenseMap<const VarDecl *, VectorInfo> declsToVector;
+    llvm::DenseMap<const FieldDecl *, unsigned> memToLoads, memToWindowLoads;
     KernelType kernelType;
 
     ASTContext &Ctx;
@@ -70,8 +72,10 @@ class KernelStatsImpl {
     unsigned num_ops, num_sops;
     unsigned num_img_loads, num_img_stores;
     unsigned num_mask_loads, num_mask_stores;
+    unsigned num_window_ops, num_window_sops;
     VectorInfo stmtVectorize;
     bool inLambdaFunction;
+    bool irregular_work;
 
     void runOnBlock(const CFGBlock *block);
     void runOnAllBlocks();
@@ -104,8 +108,11 @@ class KernelStatsImpl {
       num_img_stores(0),
       num_mask_loads(0),
       num_mask_stores(0),
+      num_window_ops(0),
+      num_window_sops(0),
       stmtVectorize(SCALAR),
-      inLambdaFunction(false)
+      inLambdaFunction(false),
+      irregular_work(false)
     {}
 };
 }
@@ -115,6 +122,32 @@ static KernelStatsImpl &getImpl(void *x) {
 }
 
 
+// checks if the value of an expression may differ from pixel to pixel, i.e.
+// depends on local variables other than the loop variable or on image reads
+static bool isDataDependent(const Stmt *S, const VarDecl *loop_var) {
+  if (!S) return false;
+
+  if (auto DRE = dyn_cast<DeclRefExpr>(S)) {
+    if (auto VD = dyn_cast<VarDecl>(DRE->getDecl())) {
+      if (VD == loop_var || !VD->hasLocalStorage()) return false;
+      // constant local variables depend on data only via their initializer
+      if (VD->getType().isConstQualified())
+        return isDataDependent(VD->getInit(), loop_var);
+      return true;
+    }
+    return false;
+  }
+
+  // Accessor, Mask, and Domain reads
+  if (isa<CXXOperatorCallExpr>(S) || isa<CXXMemberCallExpr>(S)) return true;
+
+  for (auto child : S->children())
+    if (isDataDependent(child, loop_var)) return true;
+
+  return false;
+}
+
+
 //===----------------------------------------------------------------------===//
 // Transfer functions.
 //===----------------------------------------------------------------------===//
@@ -134,7 +167,7 @@ class TransferFunctions : public StmtVisitor<TransferFunctions> {
     void VisitBinaryOperator(BinaryOperator *E);
     void VisitUnaryOperator(UnaryOperator *E);
     void VisitCallExpr(CallExpr *E);
-    void VisitCXXMemberCallExpr(CXXMemberCallExpr *) {}
+    void VisitCXXMemberCallExpr(CXXMemberCallExpr *E);
     void VisitCXXOperatorCallExpr(CXXOperatorCallExpr *) {}
     void VisitCStyleCastExpr(CStyleCastExpr *E);
     void VisitDeclStmt(DeclStmt *S);
@@ -182,6 +215,42 @@ void KernelStatsImpl::runOnBlock(const CFGBlock *block) {
     }
   }
 
+  // loops with data-dependent trip count and early exits make the work per
+  // pixel irregular
+  if (const Stmt *term = block->getTerminator()) {
+    switch (term->getStmtClass()) {
+      default: break;
+      case Stmt::ForStmtClass: {
+        const ForStmt *S = static_cast<const ForStmt *>(term);
+        const VarDecl *loop_var = nullptr;
+        if (auto DS = dyn_cast_or_null<DeclStmt>(S->getInit())) {
+          if (DS->isSingleDecl())
+            loop_var = dyn_cast<VarDecl>(DS->getSingleDecl());
+        }
+        if (isDataDependent(S->getCond(), loop_var))
+          irregular_work = true;
+        break;
+      }
+      case Stmt::WhileStmtClass:
+      case Stmt::DoStmtClass:
+        irregular_work = true;
+        break;
+      case Stmt::BreakStmtClass: {
+        // only breaks leaving a loop, not a switch statement
+        ParentMap &PM = analysisContext.getParentMap();
+        for (const Stmt *S = PM.getParent(term); S; S = PM.getParent(S)) {
+          if (isa<SwitchStmt>(S)) break;
+          if (isa<ForStmt>(S) || isa<WhileStmt>(S) || isa<DoStmt>(S) ||
+              isa<CXXForRangeStmt>(S)) {
+            irregular_work = true;
+            break;
+          }
+        }
+        break;
+      }
+    }
+  }
+
   #ifdef DEBUG_ANALYSIS
   // visit the terminator (if any).
   if (const Stmt *term = block->getTerminator()) {
@@ -243,7 +312,9 @@ void KernelStatsImpl::runOnAllBlocks() {
                << "  image loads: "         << num_img_loads << "\n"
                << "  image stores: "        << num_img_stores << "\n"
                << "  mask loads: "          << num_mask_loads << "\n"
-               << "  mask stores: "         << num_mask_stores << "\n";
+               << "  mask stores: "         << num_mask_stores << "\n"
+               << "  irregular work: "      << (irregular_work ? "yes" : "no")
+               << "\n";
 
   llvm::errs() << "  images:\n";
   for (auto map : memToPattern) {
@@ -296,6 +367,29 @@ KernelType KernelStatistics::getKernelType() {
 }
 
 
+bool KernelStatistics::hasIrregularWork() {
+  return getImpl(impl).irregular_work;
+}
+
+
+unsigned KernelStatistics::getNumOps(bool window) {
+  KernelStatsImpl &KS = getImpl(impl);
+  return window ? KS.num_window_ops : KS.num_ops - KS.num_window_ops;
+}
+
+
+unsigned KernelStatistics::getNumSFUOps(bool window) {
+  KernelStatsImpl &KS = getImpl(impl);
+  return window ? KS.num_window_sops : KS.num_sops - KS.num_window_sops;
+}
+
+
+unsigned KernelStatistics::getNumLoads(const FieldDecl *FD, bool window) {
+  KernelStatsImpl &KS = getImpl(impl);
+  return window ? KS.memToWindowLoads.lookup(FD) : KS.memToLoads.lookup(FD);
+}
+
+
 MemoryPattern TransferFunctions::checkStride(Expr *EX, Expr *EY) {
   bool stride_x=true, stride_y=true;
 
@@ -340,7 +434,11 @@ bool TransferFunctions::checkImageAccess(Expr *E, MemoryAccess mem_acc) {
         // access to Accessor
         if (KS.compilerClasses.isTypeOfTemplateClass(FD->getType(),
               KS.compilerClasses.Accessor)) {
-          if (mem_acc & READ_ONLY) KS.num_img_loads++;
+          if (mem_acc & READ_ONLY) {
+            KS.num_img_loads++;
+            if (KS.inLambdaFunction) KS.memToWindowLoads[FD]++;
+            else KS.memToLoads[FD]++;
+          }
           if (mem_acc & WRITE_ONLY) KS.num_img_stores++;
 
           switch (call->getNumArgs()) {
@@ -442,7 +540,11 @@ bool TransferFunctions::checkImageAccess(Expr *E, MemoryAccess mem_acc) {
         }
         assert(FD && "could not find field");
 
-        if (mem_acc & READ_ONLY) KS.num_img_loads++;
+        if (mem_acc & READ_ONLY) {
+          KS.num_img_loads++;
+          if (KS.inLambdaFunction) KS.memToWindowLoads[FD]++;
+          else KS.memToLoads[FD]++;
+        }
         if (mem_acc & WRITE_ONLY) KS.num_img_stores++;
 
         MemoryPattern mem_pattern = KS.memToPattern[FD];
@@ -707,11 +809,20 @@ void TransferFunctions::VisitLambdaExpr(LambdaExpr *E) {
   AC.getCFG()->viewCFG(KS.Ctx.getLangOpts());
   #endif
 
+  unsigned num_ops = KS.num_ops, num_sops = KS.num_sops;
   KS.inLambdaFunction = true;
   auto POV = AC.getAnalysis<PostOrderCFGView>();
   for (auto block : *POV)
     KS.runOnBlock(block);
   KS.inLambdaFunction = false;
+  KS.num_window_ops += KS.num_ops - num_ops;
+  KS.num_window_sops += KS.num_sops - num_sops;
+}
+
+void TransferFunctions::VisitCXXMemberCallExpr(CXXMemberCallExpr *E) {
+  // Domain iteration stopped by break_iterate()
+  if (E->getMethodDecl() && E->getMethodDecl()->getName() == "break_iterate")
+    KS.irregular_work = true;
 }
 
 void TransferFunctions::VisitReturnStmt(ReturnStmt *S) {
@@ -35,6 +35,8 @@
 
 #include <llvm/Support/Format.h>
 
+#include <cmath>
+
 #ifdef USE_JIT_ESTIMATE
 #include <cuda_occupancy.h>
 #endif
@@ -226,6 +228,107 @@ void HipaccBoundaryCondition::setConstVal(APValue &val, ASTContext &Ctx) {
 }
 
 
+void HipaccMask::checkSeparable(ASTContext &Ctx) {
+  sep_row.clear();
+  sep_col.clear();
+
+  // only constant masks of at least 2x2 benefit from separation
+  if (!is_constant || !init_list || isDomain() || size_x < 2 || size_y < 2)
+    return;
+
+  QualType QT = getType();
+  bool isFloat = QT->isSpecificBuiltinType(BuiltinType::Float) ||
+                 QT->isSpecificBuiltinType(BuiltinType::Double);
+  if (!isFloat && !QT->isIntegerType())
+    return;
+
+  // evaluate coefficients, the largest one is used as pivot
+  SmallVector<double, 64> coeffs;
+  size_t pivot_x = 0, pivot_y = 0;
+  for (size_t y=0; y<size_y; ++y) {
+    for (size_t x=0; x<size_x; ++x) {
+      Expr::EvalResult val;
+      if (!getInitExpr(x, y)->EvaluateAsRValue(val, Ctx))
+        return;
+
+      double coeff = 0;
+      if (val.Val.isInt()) {
+        coeff = static_cast<double>(val.Val.getInt().getSExtValue());
+      } else if (val.Val.isFloat()) {
+        bool loses_info;
+        llvm::APFloat fval = val.Val.getFloat();
+        fval.convert(llvm::APFloat::IEEEdouble(),
+            llvm::APFloat::rmNearestTiesToEven, &loses_info);
+        coeff = fval.convertToDouble();
+      } else {
+        return;
+      }
+
+      if (std::abs(coeff) > std::abs(coeffs.empty() ? 0 :
+            coeffs[pivot_y*size_x + pivot_x])) {
+        pivot_x = x;
+        pivot_y = y;
+      }
+      coeffs.push_back(coeff);
+    }
+  }
+  auto coeff = [&] (size_t x, size_t y) { return coeffs[y*size_x + x]; };
+  double pivot = coeff(pivot_x, pivot_y);
+  if (pivot == 0)
+    return;
+
+  // mask[y][x] = col[y] * row[x], using the pivot row as row vector
+  SmallVector<double, 16> row, col;
+  for (size_t x=0; x<size_x; ++x)
+    row.push_back(coeff(x, pivot_y));
+  if (!isFloat) {
+    // integer masks require integer factors: divide the row by its gcd
+    int64_t gcd = 0;
+    for (auto r : row) {
+      int64_t a = std::abs(static_cast<int64_t>(r)), b = gcd;
+      while (b) { int64_t t = a % b; a = b; b = t; }
+      gcd = a;
+    }
+    for (auto &r : row)
+      r /= gcd;
+  }
+  for (size_t y=0; y<size_y; ++y) {
+    double c = coeff(pivot_x, y) / row[pivot_x];
+    if (!isFloat && c != std::trunc(c))
+      return;
+    col.push_back(c);
+  }
+
+  // check that the mask has rank 1
+  double eps = isFloat ? 1e-6 * std::abs(pivot) : 0;
+  for (size_t y=0; y<size_y; ++y) {
+    for (size_t x=0; x<size_x; ++x) {
+      if (std::abs(coeff(x, y) - col[y]*row[x]) > eps)
+        return;
+    }
+  }
+
+  auto create_literal = [&] (double val) -> Expr * {
+    if (QT->isSpecificBuiltinType(BuiltinType::Float))
+      return FloatingLiteral::Create(Ctx, llvm::APFloat(static_cast<float>(val)),
+          false, QT, SourceLocation());
+    if (isFloat)
+      return FloatingLiteral::Create(Ctx, llvm::APFloat(val), false, QT,
+          SourceLocation());
+    // integer literals narrower than int are promoted anyway
+    QualType LT = Ctx.getTypeSize(QT) < Ctx.getTypeSize(Ctx.IntTy) ?
+      Ctx.IntTy : QT;
+    return new (Ctx) IntegerLiteral(Ctx, llvm::APInt(Ctx.getTypeSize(LT),
+          static_cast<int64_t>(val), LT->isSignedIntegerType()), LT,
+        SourceLocation());
+  };
+  for (auto r : row)
+    sep_row.push_back(create_literal(r));
+  for (auto c : col)
+    sep_col.push_back(create_literal(c));
+}
+
+
 void HipaccKernel::calcSizes() {
   for (auto map : imgMap) {
     // only Accessors with proper border handling mode
@@ -459,6 +562,157 @@ void HipaccKernel::setDefaultConfig() {
   num_threads_y = default_num_threads_y;
 }
 
+void HipaccKernel::calcCPUTile() {
+  if (options.useCPUTiling(USER_ON)) {
+    cpu_tile_x = options.getCPUTileX();
+    cpu_tile_y = options.getCPUTileY();
+    return;
+  }
+
+  // bytes read and written per pixel
+  unsigned pixel_bytes = 0;
+  for (auto map : imgMap)
+    pixel_bytes += Ctx.getTypeSize(map.second->getImage()->getType()) / 8;
+  if (pixel_bytes == 0) pixel_bytes = 1;
+
+  // the tile plus its halo should occupy at most half of the L2 cache; tiles
+  // cover the window several times in y and are as wide as possible in x to
+  // keep hardware prefetching effective
+  unsigned halo_x = max_size_x_undef > 1 ? max_size_x_undef - 1 : 0;
+  unsigned halo_y = max_size_y_undef > 1 ? max_size_y_undef - 1 : 0;
+  unsigned tile_pixels = l2_cache_size / 2 / pixel_bytes;
+  cpu_tile_y = std::max(8u, 4*(halo_y + 1));
+  cpu_tile_x = tile_pixels / (cpu_tile_y + halo_y);
+  cpu_tile_x = cpu_tile_x > halo_x ? cpu_tile_x - halo_x : 0;
+  cpu_tile_x = std::max(64u, cpu_tile_x & ~63u);
+}
+
+
+unsigned HipaccKernel::getCPUVectorWidth() {
+  // the narrowest pixel type determines the number of lanes
+  unsigned pixel_bytes = Ctx.getTypeSize(iterationSpace->getImage()->getType())/8;
+  for (auto map : imgMap)
+    pixel_bytes = std::min(pixel_bytes,
+        (unsigned)Ctx.getTypeSize(map.second->getImage()->getType())/8);
+  unsigned lanes = std::min(32u, vector_size / std::max(1u, pixel_bytes));
+
+  // variables depending on image reads are widened to the number of lanes;
+  // limit each of them to four registers
+  for (auto decl : KC->getKernelFunction()->decls()) {
+    if (auto VD = dyn_cast<VarDecl>(decl)) {
+      if (KC->getVectorizeInfo(VD) != VECTORIZE) continue;
+      unsigned bytes = Ctx.getTypeSize(VD->getType())/8;
+      while (lanes > 8 && lanes*bytes > 4*vector_size) lanes /= 2;
+    }
+  }
+
+  return std::max(1u, lanes);
+}
+
+
+void HipaccKernel::printIntensity() {
+  KernelStatistics &KS = KC->getKernelStatistics();
+
+  // lambda-functions of convolve(), reduce(), and iterate() are executed for
+  // each element of the largest Mask or Domain
+  unsigned window = 1;
+  for (auto map : maskMap)
+    window = std::max(window, map.second->getSizeX()*map.second->getSizeY());
+
+  unsigned ops = KS.getNumOps() + sfu_cost*KS.getNumSFUOps();
+  unsigned window_ops = KS.getNumOps(true) + sfu_cost*KS.getNumSFUOps(true);
+  float ops_per_pixel = std::max(1u, ops + window*window_ops);
+
+  // bytes read per pixel if each access goes to memory, and if each pixel of
+  // an image is read once and reused from caches or line buffers
+  unsigned bytes_no_reuse = 0, bytes_read = 0;
+  for (auto map : imgMap) {
+    HipaccAccessor *acc = map.second;
+    unsigned loads = KS.getNumLoads(map.first) +
+                     window*KS.getNumLoads(map.first, true);
+    if (acc == iterationSpace || !loads) continue;
+    unsigned pixel_bytes = Ctx.getTypeSize(acc->getImage()->getType())/8;
+    bytes_no_reuse += loads*pixel_bytes;
+    bytes_read += pixel_bytes;
+  }
+  unsigned bytes_written =
+    Ctx.getTypeSize(iterationSpace->getImage()->getType())/8;
+  float intensity = ops_per_pixel / (bytes_read + bytes_written);
+
+  llvm::errs() << "Arithmetic intensity of kernel '" << kernelName << "'\n";
+  llvm::errs() << "  Operations per pixel: "
+               << llvm::format("%.0f", ops_per_pixel) << " (" << ops;
+  if (window_ops)
+    llvm::errs() << " + " << window << "x" << window_ops << " window";
+  llvm::errs() << ", SFU operations count " << sfu_cost << ")\n";
+  llvm::errs() << "  Bytes per pixel: " << bytes_read << " read ("
+               << bytes_no_reuse << " without reuse), " << bytes_written
+               << " written\n";
+  llvm::errs() << "  Arithmetic intensity: " << llvm::format("%.2f", intensity)
+               << " op/byte\n";
+
+  if (peak_gops <= 0 || peak_bandwidth <= 0) {
+    llvm::errs() << "  Bound: unknown, use -report-intensity <n:m> to specify "
+                 << "the peak performance of the target\n";
+    return;
+  }
+
+  // roofline: attainable pixels per second are limited either by the peak
+  // performance or by the bandwidth to memory; FPGA pipelines accept at most
+  // one stream element of pixels-per-thread pixels every II cycles,
+  // column-parallel lanes up to one element per cycle
+  float ridge = peak_gops / peak_bandwidth;
+  float compute_mpixels = peak_gops*1000 / ops_per_pixel;
+  float memory_mpixels = peak_bandwidth*1000 / (bytes_read + bytes_written);
+  float mpixels = std::min(compute_mpixels, memory_mpixels);
+  std::string bound = intensity >= ridge ? "compute" : "memory";
+  if (fpga_clock > 0) {
+    int lanes = 1;
+    if (options.emitVivado() && KC->getMaskFields().size() &&
+        KC->getImgFields().size() <= 2)
+      lanes = std::min(options.getFPGALanes(), options.getTargetII());
+    int ppt = options.emitVivado() ? options.getPixelsPerThread() : 1;
+    float pipeline_mpixels = fpga_clock*1000 * lanes * ppt /
+                             options.getTargetII();
+    if (pipeline_mpixels < mpixels) {
+      mpixels = pipeline_mpixels;
+      bound = "pipeline (II=" + std::to_string(options.getTargetII()) + ")";
+    }
+  }
+  llvm::errs() << "  Bound: " << bound << " (ridge point "
+               << llvm::format("%.2f", ridge) << " op/byte at "
+               << llvm::format("%.0f", peak_gops) << " Gop/s, "
+               << llvm::format("%.1f", peak_bandwidth) << " GB/s), at most "
+               << llvm::format("%.0f", mpixels) << " Mpixel/s\n";
+}
+
+
+void HipaccKernel::getFusedArgs(std::string prefix,
+    SmallVectorImpl<FusedArg> &args) {
+  // the arguments of the kernel itself, followed by the arguments of the
+  // producers fused into it
+  for (HipaccKernel *K = this; K; K = K->getFusedProducer()) {
+    if (K != this) prefix += K->getName() + "_";
+
+    size_t i = 0;
+    for (auto arg : K->getDeviceArgFields()) {
+      size_t idx = i++;
+      std::string name = K->getDeviceArgNames()[idx];
+      if (!K->getUsed(name))
+        continue;
+
+      // constant masks are no parameters
+      if (auto Mask = K->getMaskFromMapping(arg)) {
+        if (Mask->isConstant())
+          continue;
+        name = Mask->getName() + K->getName();
+      }
+
+      args.push_back({ K, idx, prefix + name });
+    }
+  }
+}
+
 void HipaccKernel::addParam(QualType QT1, QualType QT2, QualType QT3,
     std::string typeC, std::string typeO, std::string name, FieldDecl *fd) {
   switch (options.getTargetLang()) {
@@ -34,6 +34,8 @@
 
 #include "hipacc/Rewrite/CreateHostStrings.h"
 
+#include <algorithm>
+
 using namespace clang;
 using namespace hipacc;
 
@@ -435,7 +437,8 @@ void CreateHostStrings::writeMemoryTransferDomainFromMask(
 }
 
 
-void CreateHostStrings::writeKernelCall(HipaccKernel *K, bool isOutputProcess, std::string &resultStr) {
+void CreateHostStrings::writeKernelCall(HipaccKernel *K, bool isOutputProcess,
+    std::string &resultStr, std::string asyncArgs) {
   auto argTypeNames = K->getArgTypeNames();
   auto deviceArgNames = K->getDeviceArgNames();
   auto hostArgNames = K->getHostArgNames();
@@ -448,7 +451,9 @@ void CreateHostStrings::writeKernelCall(HipaccKernel *K, bool isOutputProcess, s
 
   switch (options.getTargetLang()) {
     case Language::Vivado: return;
-    case Language::C99: break;
+    case Language::C99:
+      writeCPUKernelLaunch(K, resultStr);
+      return;
     case Language::CUDA:
       blockStr = "block" + lit;
       gridStr = "grid" + lit;
@@ -739,23 +744,7 @@ void CreateHostStrings::writeKernelCall(HipaccKernel *K, bool isOutputProcess, s
       // set kernel arguments
       switch (options.getTargetLang()) {
         case Language::Vivado:
-        case Language::C99:
-          if (i==0) {
-            resultStr += "hipaccStartTiming();\n";
-            resultStr += indent;
-            resultStr += kernel_name + "(";
-          } else {
-            resultStr += ", ";
-          }
-          if (Acc) {
-            resultStr += "(" + Acc->getImage()->getTypeStr();
-            resultStr += "(*)[" + Acc->getImage()->getSizeXStr() + "])";
-          }
-          if (Mask) {
-            resultStr += "(" + argTypeNames[i] + ")";
-          }
-          resultStr += hostArgNames[i] + img_mem;
-          break;
+        case Language::C99: break;
         case Language::CUDA:
           resultStr += "_args" + kernel_name + ".push_back(";
           resultStr += "(void *)&" + hostArgNames[i] + img_mem + ");\n";
@@ -789,13 +778,6 @@ void CreateHostStrings::writeKernelCall(HipaccKernel *K, bool isOutputProcess, s
       }
     }
   }
-  if (options.getTargetLang()==Language::C99) {
-    // close parenthesis for function call
-    resultStr += ");\n";
-    resultStr += indent;
-    resultStr += "hipaccStopTiming();\n";
-    resultStr += indent;
-  }
   resultStr += "\n" + indent;
 
   // launch kernel
@@ -891,6 +873,14 @@ void CreateHostStrings::writeKernelCall(HipaccKernel *K, bool isOutputProcess, s
       case Language::OpenCLCPU:
       case Language::OpenCLFPGA:
       case Language::OpenCLGPU:
+        if (!asyncArgs.empty()) {
+          resultStr += "hipaccLaunchKernelAsync(";
+          resultStr += kernel_name;
+          resultStr += ", " + gridStr;
+          resultStr += ", " + blockStr;
+          resultStr += ", " + asyncArgs + ");";
+          break;
+        }
         resultStr += "hipaccLaunchKernel(";
         resultStr += kernel_name;
         resultStr += ", " + gridStr;
@@ -911,6 +901,312 @@ void CreateHostStrings::writeKernelCall(HipaccKernel *K, bool isOutputProcess, s
 }
 
 
+// bytes read per pixel of the iteration space from the images accessed by a
+// kernel and the point operators fused into it
+unsigned CreateHostStrings::getPixelBytesRead(HipaccKernel *K) {
+  unsigned bytes = 0;
+  for (auto arg : K->getDeviceArgFields()) {
+    HipaccAccessor *Acc = K->getImgFromMapping(arg);
+    if (Acc && Acc != K->getIterationSpace() &&
+        (K->getKernelClass()->getMemAccess(arg) & READ_ONLY))
+      bytes += Acc->getImage()->getPixelSize();
+  }
+  if (HipaccKernel *producer = K->getFusedProducer())
+    bytes += getPixelBytesRead(producer);
+
+  return bytes;
+}
+
+
+// C/C++ kernels record their launches in the profiler of the runtime:
+// hipaccStopTiming("ccFooKernel", IS.width, IS.height, bytes_read, bytes_written);
+std::string CreateHostStrings::getStopTimingStr(std::string name,
+    HipaccAccessor *IS, unsigned bytes_read, unsigned bytes_written) {
+  if (!options.emitC99())
+    return "hipaccStopTiming();\n";
+
+  return "hipaccStopTiming(\"" + name + "\", " + IS->getName() + ".width, " +
+    IS->getName() + ".height, " + std::to_string(bytes_read) + ", " +
+    std::to_string(bytes_written) + ");\n";
+}
+
+
+// kernels timed together are recorded as one launch, e.g. ccFoo+ccBar
+std::string CreateHostStrings::getStopTimingStr(ArrayRef<HipaccKernel *>
+    kernels) {
+  std::string name;
+  unsigned bytes_read = 0, bytes_written = 0;
+  for (auto K : kernels) {
+    if (!name.empty()) name += "+";
+    name += K->getKernelName();
+    bytes_read += getPixelBytesRead(K);
+    bytes_written += K->getIterationSpace()->getImage()->getPixelSize();
+  }
+
+  return getStopTimingStr(name, kernels[0]->getIterationSpace(), bytes_read,
+      bytes_written);
+}
+
+
+void CreateHostStrings::writeCPUKernelLaunch(HipaccKernel *K,
+    std::string &resultStr) {
+  std::string kernel_name(K->getKernelName());
+  std::string IS(K->getIterationSpace()->getName());
+  std::vector<CPUConfig> configs(options.getCPUConfigs(kernel_name));
+
+  if (!options.useCPUConfigParams() ||
+      (!options.exploreConfig() && configs.empty())) {
+    resultStr += "hipaccStartTiming();\n";
+    resultStr += indent;
+    writeCPUKernelCall(K, "0", IS + ".height", resultStr);
+    resultStr += indent;
+    resultStr += getStopTimingStr(K);
+    resultStr += indent;
+    resultStr += "\n" + indent;
+    return;
+  }
+
+  // configuration selected by the heuristics of the compiler
+  bool tiled = K->getKernelClass()->getKernelType() == LocalOperator;
+  std::string heuristic("HipaccCPUConfig(" + IS + ".width, " + IS + ".height, ");
+  heuristic += std::to_string(options.useMultiThreading() ?
+      options.getCPUThreads() : 1) + ", ";
+  heuristic += std::to_string(tiled ? K->getCPUTileX() : 0) + ", ";
+  heuristic += std::to_string(tiled ? K->getCPUTileY() : 0) + ")";
+
+  if (options.exploreConfig()) {
+    // the runtime times the kernel for each configuration and stores the best
+    // one in the tuning file:
+    // hipaccLaunchKernelExploration("ccFooKernel", "hipacc_tuning.conf",
+    //     heuristic, tiled, [&] (const HipaccCPUConfig &_config) {
+    //   ccFooKernel(..., _config.threads, _config.tile_x, _config.tile_y);
+    // });
+    resultStr += "hipaccLaunchKernelExploration(\"" + kernel_name + "\", ";
+    resultStr += "\"" + options.getTuningFile() + "\", " + heuristic + ", ";
+    resultStr += std::string(tiled ? "true" : "false");
+    resultStr += ", [&] (const HipaccCPUConfig &_config) {\n";
+    inc_indent();
+    resultStr += indent;
+    writeCPUKernelCall(K, "0", IS + ".height", resultStr, "_config");
+    dec_indent();
+    resultStr += indent + "});\n";
+    resultStr += indent;
+    resultStr += "\n" + indent;
+    return;
+  }
+
+  // the configuration tuned for the image size closest to the iteration space
+  resultStr += "{\n";
+  inc_indent();
+  resultStr += indent + "HipaccCPUConfig _config = hipaccSelectCPUConfig(";
+  resultStr += heuristic + ", {\n";
+  inc_indent();
+  for (size_t i=0; i<configs.size(); ++i) {
+    resultStr += indent + "HipaccCPUConfig(";
+    resultStr += std::to_string(configs[i].width) + ", ";
+    resultStr += std::to_string(configs[i].height) + ", ";
+    resultStr += std::to_string(configs[i].threads) + ", ";
+    resultStr += std::to_string(configs[i].tile_x) + ", ";
+    resultStr += std::to_string(configs[i].tile_y) + ")";
+    if (i+1 < configs.size()) resultStr += ",";
+    resultStr += "\n";
+  }
+  dec_indent();
+  resultStr += indent + "});\n";
+  resultStr += indent + "hipaccStartTiming();\n";
+  resultStr += indent;
+  writeCPUKernelCall(K, "0", IS + ".height", resultStr, "_config");
+  resultStr += indent + getStopTimingStr(K);
+  dec_indent();
+  resultStr += indent + "}\n";
+  resultStr += indent;
+  resultStr += "\n" + indent;
+}
+
+
+void CreateHostStrings::writeCPUKernelCall(HipaccKernel *K,
+    std::string rowLower, std::string rowUpper, std::string &resultStr,
+    std::string config) {
+  auto argTypeNames = K->getArgTypeNames();
+  auto hostArgNames = K->getHostArgNames();
+
+  resultStr += K->getKernelName() + "(";
+
+  size_t comma = 0;
+  size_t num_arg = 0;
+  for (auto arg : K->getDeviceArgFields()) {
+    size_t i = num_arg++;
+
+    // skip unused variables
+    if (!K->getUsed(K->getDeviceArgNames()[i]))
+      continue;
+
+    HipaccMask *Mask = K->getMaskFromMapping(arg);
+    if (Mask && Mask->isConstant())
+      continue;
+
+    if (comma++)
+      resultStr += ", ";
+
+    if (auto Acc = K->getImgFromMapping(arg)) {
+      resultStr += "(" + Acc->getImage()->getTypeStr();
+      resultStr += "(*)[" + Acc->getImage()->getSizeXStr() + "])";
+      resultStr += hostArgNames[i] + "->mem";
+    } else if (Mask) {
+      resultStr += "(" + argTypeNames[i] + ")";
+      resultStr += hostArgNames[i] + "->mem";
+    } else {
+      resultStr += hostArgNames[i];
+    }
+  }
+
+  // arguments of the point operators fused into the kernel
+  if (HipaccKernel *producer = K->getFusedProducer()) {
+    SmallVector<HipaccKernel::FusedArg, 16> fusedArgs;
+    producer->getFusedArgs(producer->getName() + "_", fusedArgs);
+    for (auto arg : fusedArgs) {
+      FieldDecl *FD = arg.K->getDeviceArgFields()[arg.idx];
+      std::string hostArg = arg.K->getHostArgNames()[arg.idx];
+      resultStr += ", ";
+      if (auto Acc = arg.K->getImgFromMapping(FD)) {
+        resultStr += "(" + Acc->getImage()->getTypeStr();
+        resultStr += "(*)[" + Acc->getImage()->getSizeXStr() + "])";
+        resultStr += hostArg + "->mem";
+      } else if (arg.K->getMaskFromMapping(FD)) {
+        resultStr += "(" + arg.K->getArgTypeNames()[arg.idx] + ")";
+        resultStr += hostArg + "->mem";
+      } else {
+        resultStr += hostArg;
+      }
+    }
+  }
+
+  // rows of the iteration space processed by this call
+  if (options.useRowRanges()) {
+    resultStr += ", " + rowLower + ", " + rowUpper;
+  }
+
+  // number of threads and tile size, the heuristic ones if no configuration
+  // is explored or tuned for the call
+  if (options.useCPUConfigParams()) {
+    if (config.empty()) {
+      bool tiled = K->getKernelClass()->getKernelType() == LocalOperator;
+      resultStr += ", " + std::to_string(options.useMultiThreading() ?
+          options.getCPUThreads() : 1);
+      resultStr += ", " + std::to_string(tiled ? K->getCPUTileX() : 0);
+      resultStr += ", " + std::to_string(tiled ? K->getCPUTileY() : 0);
+    } else {
+      resultStr += ", " + config + ".threads";
+      resultStr += ", " + config + ".tile_x";
+      resultStr += ", " + config + ".tile_y";
+    }
+  }
+
+  resultStr += ");\n";
+}
+
+
+void CreateHostStrings::writeStreamedKernelCalls(ArrayRef<HipaccKernel *>
+    kernels, ArrayRef<unsigned> lags, unsigned rows, std::string &resultStr) {
+  std::string row("_row" + std::to_string(literal_count++));
+  std::string height(kernels[0]->getIterationSpace()->getName() + ".height");
+  unsigned max_lag = *std::max_element(lags.begin(), lags.end());
+
+  // process the kernels band by band; each kernel trails the kernels it
+  // depends on by the rows its accessor windows reach ahead:
+  // for (int _row=0; _row<height+max_lag; _row+=rows) {
+  //   ccFooKernel(..., _row-lag_foo, _row-lag_foo+rows);
+  //   ccBarKernel(..., _row-lag_bar, _row-lag_bar+rows);
+  // }
+  resultStr += "hipaccStartTiming();\n";
+  resultStr += indent;
+  resultStr += "for (int " + row + "=0; " + row + "<" + height;
+  if (max_lag) resultStr += "+" + std::to_string(max_lag);
+  resultStr += "; " + row + "+=" + std::to_string(rows) + ") {\n";
+  inc_indent();
+  for (size_t i=0; i<kernels.size(); ++i) {
+    std::string lower(row);
+    if (lags[i]) lower += "-" + std::to_string(lags[i]);
+    resultStr += indent;
+    writeCPUKernelCall(kernels[i], lower, lower + "+" + std::to_string(rows),
+        resultStr);
+  }
+  dec_indent();
+  resultStr += indent + "}\n";
+  resultStr += indent;
+  resultStr += getStopTimingStr(kernels);
+  resultStr += indent;
+}
+
+
+void CreateHostStrings::writeConcurrentKernelCalls(ArrayRef<HipaccKernel *>
+    kernels, std::string &resultStr) {
+  std::string threads(options.useMultiThreading() ?
+      std::to_string(options.getCPUThreads()) : "0");
+
+  // the runtime distributes bands of rows of all kernels among its threads:
+  // hipaccRunConcurrently(threads, {
+  //   HipaccTask(height_foo, [&] (int _lower, int _upper) {
+  //     ccFooKernel(..., _lower, _upper);
+  //   }),
+  //   HipaccTask(height_bar, [&] (int _lower, int _upper) {
+  //     ccBarKernel(..., _lower, _upper);
+  //   })
+  // });
+  resultStr += "hipaccStartTiming();\n";
+  resultStr += indent;
+  resultStr += "hipaccRunConcurrently(" + threads + ", {\n";
+  inc_indent();
+  for (size_t i=0; i<kernels.size(); ++i) {
+    resultStr += indent + "HipaccTask(";
+    resultStr += kernels[i]->getIterationSpace()->getName() + ".height, ";
+    resultStr += "[&] (int _lower, int _upper) {\n";
+    inc_indent();
+    resultStr += indent;
+    writeCPUKernelCall(kernels[i], "_lower", "_upper", resultStr);
+    dec_indent();
+    resultStr += indent + "})";
+    if (i+1 < kernels.size()) resultStr += ",";
+    resultStr += "\n";
+  }
+  dec_indent();
+  resultStr += indent + "});\n";
+  resultStr += indent;
+  resultStr += getStopTimingStr(kernels);
+  resultStr += indent;
+}
+
+
+void CreateHostStrings::writeAsyncKernelCalls(ArrayRef<HipaccKernel *>
+    kernels, ArrayRef<std::vector<unsigned>> deps, std::string &resultStr) {
+  std::string events("_events" + std::to_string(literal_count++));
+
+  // each kernel is launched on its own command queue and waits for the events
+  // of the kernels it depends on:
+  // std::vector<cl_event> _events0(2);
+  // ...
+  // hipaccLaunchKernelAsync(clFooKernel, global_work_size1, local_work_size1, 0, {}, &_events0[0]);
+  // ...
+  // hipaccLaunchKernelAsync(clBarKernel, global_work_size2, local_work_size2, 1, {_events0[0]}, &_events0[1]);
+  // hipaccFinishAsync(_events0);
+  resultStr += "std::vector<cl_event> " + events + "(";
+  resultStr += std::to_string(kernels.size()) + ");\n";
+  resultStr += indent;
+  for (size_t i=0; i<kernels.size(); ++i) {
+    std::string waitList;
+    for (auto dep : deps[i]) {
+      if (!waitList.empty()) waitList += ", ";
+      waitList += events + "[" + std::to_string(dep) + "]";
+    }
+    writeKernelCall(kernels[i], false, resultStr, std::to_string(i) + ", {" +
+        waitList + "}, &" + events + "[" + std::to_string(i) + "]");
+    resultStr += "\n" + indent;
+  }
+  resultStr += "hipaccFinishAsync(" + events + ");\n";
+  resultStr += indent;
+}
+
+
 void CreateHostStrings::writeReduceCall(HipaccKernel *K, std::string &resultStr) {
   std::string typeStr(K->getIterationSpace()->getImage()->getTypeStr());
   std::string red_decl(typeStr + " " + K->getReduceStr() + " = ");
@@ -935,7 +1231,8 @@ void CreateHostStrings::writeReduceCall(HipaccKernel *K, std::string &resultStr)
       }
       resultStr += ");\n";
       resultStr += indent;
-      resultStr += "hipaccStopTiming();\n";
+      resultStr += getStopTimingStr(K->getReduceName(), K->getIterationSpace(),
+          K->getIterationSpace()->getImage()->getPixelSize(), 0);
       resultStr += indent;
       return;
     case Language::CUDA:
@@ -1069,7 +1366,8 @@ void CreateHostStrings::writeBinningCall(HipaccKernel *K, std::string &resultStr
       }
       resultStr += ");\n";
       resultStr += indent;
-      resultStr += "hipaccStopTiming();\n";
+      resultStr += getStopTimingStr(K->getBinningName(), K->getIterationSpace(),
+          K->getIterationSpace()->getImage()->getPixelSize(), 0);
       return;
     case Language::CUDA:
       // first get texture reference
@@ -1170,6 +1468,8 @@ std::string CreateHostStrings::getInterpolationDefinition(HipaccKernel *K,
       str += "_repeat, BH_REPEAT_LOWER, BH_REPEAT_UPPER, "; break;
     case Boundary::MIRROR:
       str += "_mirror, BH_MIRROR_LOWER, BH_MIRROR_UPPER, "; break;
+    case Boundary::MIRROR_101:
+      str += "_mirror_101, BH_MIRROR_101_LOWER, BH_MIRROR_101_UPPER, "; break;
     case Boundary::CONSTANT:
       str += "_constant, BH_CONSTANT_LOWER, BH_CONSTANT_UPPER, ";
       const_parameter = "CONST_PARM";
@@ -45,8 +45,10 @@
 #include "hipacc/Analysis/HostDataDeps.h"
 
 #include <clang/AST/ASTConsumer.h>
+#include <clang/AST/PrettyPrinter.h>
 #include <clang/AST/RecursiveASTVisitor.h>
 #include <clang/Rewrite/Core/Rewriter.h>
+#include <llvm/ADT/SmallPtrSet.h>
 #include <llvm/Support/Path.h>
 
 #include <errno.h>
@@ -99,6 +101,20 @@ class Rewrite : public ASTConsumer,  public RecursiveASTVisitor<Rewrite> {
     llvm::DenseMap<ValueDecl *, HipaccKernel *> KernelDeclMap;
     llvm::DenseMap<ValueDecl *, HipaccMask *> MaskDeclMap;
 
+    // point operators fused into their consumer kernel
+    std::map<ValueDecl *, ValueDecl *> FusionCandidates;
+    llvm::DenseMap<HipaccKernel *, FunctionDecl *> PixelFunctionDeclMap;
+
+    // consecutive kernel executions streamed in bands of rows
+    llvm::DenseMap<CXXMemberCallExpr *, SmallVector<CXXMemberCallExpr *, 8>>
+      StreamCandidates;
+    llvm::SmallPtrSet<CXXMemberCallExpr *, 16> StreamedCalls;
+
+    // consecutive independent kernel executions run concurrently
+    llvm::DenseMap<CXXMemberCallExpr *, SmallVector<CXXMemberCallExpr *, 8>>
+      ConcurrentCandidates;
+    llvm::SmallPtrSet<CXXMemberCallExpr *, 16> ConcurrentCalls;
+
     // store interpolation methods required for CUDA
     SmallVector<std::string, 16> InterpolationDefinitionsGlobal;
 
@@ -278,7 +294,16 @@ class Rewrite : public ASTConsumer,  public RecursiveASTVisitor<Rewrite> {
         llvm::raw_fd_ostream &OS);
     void printKernelFunction(FunctionDecl *D, HipaccKernelClass *KC,
         HipaccKernel *K, std::string file, bool emitHints);
+    void printParallelLoop(ForStmt *S, HipaccKernel *K, PrinterHelper *Helper,
+        PrintingPolicy &Policy, llvm::raw_ostream &OS);
     void createFPGAEntry();
+    void findKernelSequences(Stmt *S);
+    bool streamKernels(CXXMemberCallExpr *E);
+    bool runKernelsConcurrently(CXXMemberCallExpr *E);
+    bool launchKernelsAsync(CXXMemberCallExpr *E);
+    bool isFusible(HipaccKernelClass *KC, HipaccKernel *K);
+    void printFusedArguments(HipaccKernel *K, std::string prefix,
+        llvm::raw_ostream &OS);
 
     enum PrintParam {
       None = 0,
@@ -291,7 +316,9 @@ class Rewrite : public ASTConsumer,  public RecursiveASTVisitor<Rewrite> {
       Entry = 7
     };
 
-    Boundary fpgaBM = Boundary::UNDEFINED;
+    // border handling of the accessors in the order of the kernel call
+    SmallVector<std::pair<Boundary, Expr *>, 2> fpgaBorders;
+    bool fpgaWindow = false;
     size_t maxWindowSizeX = 1;
     size_t maxWindowSizeY = 1;
     size_t maxImageWidth = 1;
@@ -306,6 +333,24 @@ class Rewrite : public ASTConsumer,  public RecursiveASTVisitor<Rewrite> {
 
     std::map<size_t, std::pair< std::string, int > > bwMap;
 };
+
+
+// prints OpenMP SIMD directives in front of loops marked for vectorization
+class SIMDLoopPrinterHelper : public PrinterHelper {
+  private:
+    HipaccKernel *K;
+
+  public:
+    explicit SIMDLoopPrinterHelper(HipaccKernel *K) : K(K) {}
+
+    bool handledStmt(Stmt *S, llvm::raw_ostream &OS) override {
+      if (K->isSIMDLoop(S)) {
+        OS << "#pragma omp simd simdlen(" << K->getCPUVectorWidth() << ")\n";
+      }
+      // let the StmtPrinter print the loop itself
+      return false;
+    }
+};
 }
 
 
@@ -994,6 +1039,8 @@ bool Rewrite::VisitDeclStmt(DeclStmt *D) {
               "Constant expression for size argument of BoundaryCondition %1 required.");
         unsigned IDMode = Diags.getCustomDiagID(DiagnosticsEngine::Error,
               "Boundary handling constant for BoundaryCondition %0 required.");
+        unsigned IDVivadoMode = Diags.getCustomDiagID(DiagnosticsEngine::Error,
+              "Boundary handling mode of BoundaryCondition %0 not supported for Vivado%1.");
         HipaccBoundaryCondition *BC = nullptr;
         HipaccImage *Img = nullptr;
         HipaccPyramid *Pyr = nullptr;
@@ -1049,7 +1096,7 @@ bool Rewrite::VisitDeclStmt(DeclStmt *D) {
                 DRE->getDecl()->getType().getAsString() ==
                 "enum hipacc::Boundary") {
               auto lval = arg->EvaluateKnownConstInt(Context);
-              auto cval = static_cast<std::underlying_type<Boundary>::type>(Boundary::CONSTANT);
+              auto cval = static_cast<std::underlying_type<Boundary>::type>(Boundary::MIRROR_101);
               assert(lval.isNonNegative() && lval.getZExtValue() <= cval &&
                      "invalid Boundary mode");
               auto mode = static_cast<Boundary>(lval.getZExtValue());
@@ -1086,6 +1133,19 @@ bool Rewrite::VisitDeclStmt(DeclStmt *D) {
         assert((Img || Pyr) && "Expected first argument of BoundaryCondition "
                                "to be Image or Pyramid call.");
 
+        // streaming only sees a sliding window of the image: pixels from the
+        // opposite border (REPEAT) are not available, and constants are not
+        // injected into windows of vector types
+        if (compilerOptions.emitVivado()) {
+          if (BC->getBoundaryMode() == Boundary::REPEAT) {
+            Diags.Report(VD->getLocation(), IDVivadoMode) << VD->getName() << "";
+          } else if (BC->getBoundaryMode() == Boundary::CONSTANT &&
+                     BC->getImage()->getType()->isVectorType()) {
+            Diags.Report(VD->getLocation(), IDVivadoMode) << VD->getName()
+              << " with vector types";
+          }
+        }
+
 
         // remove BoundaryCondition definition
         TextRewriter.RemoveText(D->getSourceRange());
@@ -1318,6 +1378,8 @@ bool Rewrite::VisitDeclStmt(DeclStmt *D) {
         }
         Mask->setIsConstant(isMaskConstant);
         Mask->setHostMemName(V->getName());
+        if (isMaskConstant && compilerOptions.separateMasks())
+          Mask->checkSeparable(Context);
       }
 
       HipaccMask *Domain = nullptr;
@@ -1539,6 +1601,65 @@ bool Rewrite::VisitDeclStmt(DeclStmt *D) {
           // set kernel configuration
           setKernelConfiguration(KC, K);
 
+          // compute the point operator producing the input of this kernel
+          // per pixel within this kernel
+          if (FusionCandidates.count(VD) &&
+              KernelDeclMap.count(FusionCandidates[VD])) {
+            HipaccKernel *P = KernelDeclMap[FusionCandidates[VD]];
+            HipaccImage *PImg = P->getIterationSpace()->getImage();
+            HipaccImage *KImg = K->getIterationSpace()->getImage();
+            if (PixelFunctionDeclMap.count(P) && isFusible(KC, K) &&
+                PImg->getSizeXStr() == KImg->getSizeXStr() &&
+                PImg->getSizeYStr() == KImg->getSizeYStr()) {
+              K->setFusedProducer(P);
+            }
+          }
+
+          // translate the kernel body for a single pixel if the kernel can be
+          // fused into its consumer; this has to be done before the kernel
+          // itself is translated, since the used kernel arguments are reset
+          bool isProducer = false;
+          for (auto candidate : FusionCandidates)
+            if (candidate.second == VD)
+              isProducer = true;
+          if (isProducer && isFusible(KC, K)) {
+            // the intermediate image has to be written only if host code
+            // reads it; otherwise the pixel is returned to the consumer
+            K->setFusedStore(dataDeps->isOutputReadByHost(VD) ||
+                KC->getMemAccess(KC->getOutField()) != WRITE_ONLY);
+
+            // void ccFooKernel_pixel(<kernel args>, <producer args>,
+            //                        const int gid_x, const int gid_y);
+            SmallVector<QualType, 16> argTypes(K->getArgTypes().begin(),
+                K->getArgTypes().end());
+            SmallVector<std::string, 16> argNames(
+                K->getDeviceArgNames().begin(), K->getDeviceArgNames().end());
+            if (HipaccKernel *P = K->getFusedProducer()) {
+              SmallVector<HipaccKernel::FusedArg, 16> fusedArgs;
+              P->getFusedArgs(P->getName() + "_", fusedArgs);
+              for (auto arg : fusedArgs) {
+                argTypes.push_back(arg.K->getArgTypes()[arg.idx]);
+                argNames.push_back(arg.name);
+              }
+            }
+            argTypes.push_back(Context.IntTy);
+            argNames.push_back("gid_x");
+            argTypes.push_back(Context.IntTy);
+            argNames.push_back("gid_y");
+
+            FunctionDecl *pixelDecl = createFunctionDecl(Context,
+                Context.getTranslationUnitDecl(), K->getPixelFunctionName(),
+                K->getFusedStore() ? Context.VoidTy :
+                K->getIterationSpace()->getImage()->getType(), argTypes,
+                argNames);
+            ASTTranslate *Pixel = new ASTTranslate(Context, pixelDecl, K, KC,
+                builtins, compilerOptions, compilerClasses);
+            Pixel->setPixelFunction(true);
+            pixelDecl->setBody(
+                Pixel->Hipacc(KC->getKernelFunction()->getBody()));
+            PixelFunctionDeclMap[K] = pixelDecl;
+          }
+
           // kernel declaration
           FunctionDecl *kernelDecl = createFunctionDecl(Context,
               Context.getTranslationUnitDecl(), K->getKernelName(),
@@ -1556,6 +1677,8 @@ bool Rewrite::VisitDeclStmt(DeclStmt *D) {
             Hipacc->Hipacc(KC->getKernelFunction()->getBody());
           kernelDecl->setBody(kernelStmts);
           K->printStats();
+          if (compilerOptions.reportIntensity())
+            K->printIntensity();
 
           // translate binning function if we have one
           if (KC->getBinningFunction()) {
@@ -1625,6 +1748,7 @@ void Rewrite::createFPGAEntry() {
     *OS << "#define BORDER_FILL_VALUE    0\n";
     *OS << "#define HIPACC_II_TARGET     " << compilerOptions.getTargetII() << "\n";
     *OS << "#define HIPACC_PPT           " << compilerOptions.getPixelsPerThread() << "\n";
+    *OS << "#define HIPACC_LANES         " << compilerOptions.getFPGALanes() << "\n";
     *OS << "\n";
     *OS << "#include \"hipacc_vivado_types.hpp\"\n";
     *OS << "#include \"hipacc_vivado_filter.hpp\"\n\n";
@@ -1659,6 +1783,345 @@ bool Rewrite::VisitFunctionDecl(FunctionDecl *D) {
       dataDeps = HostDataDeps::parse(Context, AC, compilerClasses,
           compilerOptions);
     }
+
+    if ((compilerOptions.emitC99() && compilerOptions.fuseKernels()) ||
+        (compilerOptions.emitOpenCL() &&
+         compilerOptions.useConcurrentKernels())) {
+      AnalysisDeclContext AC(0, mainFD);
+      dataDeps = HostDataDeps::parse(Context, AC, compilerClasses,
+          compilerOptions);
+    }
+
+    if ((compilerOptions.emitC99() && (compilerOptions.fuseKernels() ||
+          compilerOptions.useStreaming())) ||
+        compilerOptions.useConcurrentKernels()) {
+      findKernelSequences(mainFD->getBody());
+    }
+  }
+
+  return true;
+}
+
+
+void Rewrite::findKernelSequences(Stmt *S) {
+  // returns the kernel instance executed by the statement
+  auto get_kernel = [] (CXXMemberCallExpr *E) -> ValueDecl * {
+    if (E->getDirectCallee() &&
+        E->getDirectCallee()->getNameAsString() == "execute") {
+      if (auto DRE = dyn_cast<DeclRefExpr>(
+            E->getImplicitObjectArgument()->IgnoreParenCasts()))
+        return DRE->getDecl();
+    }
+    return nullptr;
+  };
+
+  SmallVector<CXXMemberCallExpr *, 8> sequence;
+  auto add_sequence = [&] () {
+    if (sequence.size() > 1) {
+      // a kernel can be fused into its consumer if the consumer is executed
+      // right after it and is the only kernel reading its output
+      if (compilerOptions.fuseKernels()) {
+        for (size_t i=1; i<sequence.size(); ++i) {
+          ValueDecl *producer = get_kernel(sequence[i-1]);
+          ValueDecl *consumer = get_kernel(sequence[i]);
+          if (dataDeps->getFusibleProducer(consumer) == producer)
+            FusionCandidates[consumer] = producer;
+        }
+      }
+
+      // the execution order of the sequence is the schedule for streaming
+      if (compilerOptions.useStreaming())
+        StreamCandidates[sequence[0]] = sequence;
+
+      // independent kernels of the sequence may run concurrently
+      if (compilerOptions.useConcurrentKernels())
+        ConcurrentCandidates[sequence[0]] = sequence;
+    }
+    sequence.clear();
+  };
+
+  for (auto child : S->children()) {
+    auto E = dyn_cast_or_null<CXXMemberCallExpr>(child);
+    if (E && isa<CompoundStmt>(S) && get_kernel(E)) {
+      sequence.push_back(E);
+      continue;
+    }
+
+    add_sequence();
+    if (child)
+      findKernelSequences(child);
+  }
+  add_sequence();
+}
+
+
+bool Rewrite::streamKernels(CXXMemberCallExpr *E) {
+  SmallVector<CXXMemberCallExpr *, 8> calls = StreamCandidates[E];
+
+  auto get_kernel = [&] (CXXMemberCallExpr *E) -> HipaccKernel * {
+    auto DRE = cast<DeclRefExpr>(E->getImplicitObjectArgument()->
+        IgnoreParenCasts());
+    return KernelDeclMap.count(DRE->getDecl()) ?
+      KernelDeclMap[DRE->getDecl()] : nullptr;
+  };
+
+  // Each kernel processes a band of rows once the kernels producing its
+  // input images are ahead by the rows its accessor window reaches down.
+  // This requires kernels operating on images of the same height, each image
+  // written by one kernel and not read by previous kernels of the sequence.
+  SmallVector<HipaccKernel *, 8> kernels;
+  SmallVector<unsigned, 8> lags;
+  llvm::DenseMap<HipaccImage *, unsigned> written;
+  llvm::SmallPtrSet<HipaccImage *, 16> read;
+  std::string height;
+  size_t num_calls = 0;
+  for (size_t i=0; i<calls.size(); ++i) {
+    HipaccKernel *K = get_kernel(calls[i]);
+    if (!K) break;
+
+    // point operators fused into their consumer are computed by the consumer
+    if (K->getFusedConsumer()) continue;
+
+    bool valid = true;
+    unsigned lag = 0;
+    SmallVector<HipaccImage *, 4> outputs;
+    SmallVector<HipaccImage *, 8> inputs;
+    for (HipaccKernel *FK = K; FK; FK = FK->getFusedProducer()) {
+      HipaccKernelClass *KC = FK->getKernelClass();
+      HipaccIterationSpace *IS = FK->getIterationSpace();
+      if (KC->getReduceFunction() || KC->getBinningFunction() ||
+          IS->isCrop())
+        valid = false;
+      if (height.empty())
+        height = IS->getImage()->getSizeYStr();
+      if (IS->getImage()->getSizeYStr() != height)
+        valid = false;
+      outputs.push_back(IS->getImage());
+
+      for (auto img : KC->getImgFields()) {
+        HipaccAccessor *Acc = FK->getImgFromMapping(img);
+        if (Acc->isIterationSpace()) continue;
+
+        HipaccImage *Img = Acc->getImage();
+        if (Img == IS->getImage())
+          valid = false;
+        if (written.count(Img)) {
+          if (Acc->isCrop() || Acc->getInterpolationMode() != Interpolate::NO)
+            valid = false;
+          lag = std::max(lag, written[Img] + (Acc->getSizeY() >> 1));
+        }
+        inputs.push_back(Img);
+      }
+    }
+    for (auto Img : outputs) {
+      if (written.count(Img) || read.count(Img))
+        valid = false;
+    }
+    if (!valid) break;
+
+    for (auto Img : outputs)
+      written[Img] = lag;
+    for (auto Img : inputs)
+      read.insert(Img);
+    kernels.push_back(K);
+    lags.push_back(lag);
+    num_calls = i + 1;
+  }
+
+  if (kernels.size() < 2) {
+    num_calls = 1;
+  }
+  // the remaining kernels may be streamed on their own
+  if (calls.size() - num_calls > 1) {
+    StreamCandidates[calls[num_calls]] = SmallVector<CXXMemberCallExpr *, 8>(
+        calls.begin() + num_calls, calls.end());
+  }
+  if (kernels.size() < 2) return false;
+
+  // set host argument names and retrieve literals stored to temporaries
+  std::string newStr;
+  for (size_t i=0; i<num_calls; ++i) {
+    HipaccKernel *K = get_kernel(calls[i]);
+    CXXConstructExpr *CCE = dyn_cast<CXXConstructExpr>(K->getDecl()->getInit());
+    K->setHostArgNames(llvm::makeArrayRef(CCE->getArgs(),
+          CCE->getNumArgs()), newStr, literalCount);
+    if (i) StreamedCalls.insert(calls[i]);
+  }
+
+  // bands of the size of the largest window
+  unsigned rows = 1;
+  for (auto K : kernels)
+    rows = std::max(rows, 2*K->getMaxSizeY() + 1);
+
+  stringCreator.writeStreamedKernelCalls(kernels, lags, rows, newStr);
+
+  // replace the first kernel invocation by the streamed invocations
+  SourceLocation startLoc = E->getLocStart();
+  const char *startBuf = SM.getCharacterData(startLoc);
+  const char *semiPtr = strchr(startBuf, ';');
+  TextRewriter.ReplaceText(startLoc, semiPtr-startBuf+1, newStr);
+
+  return true;
+}
+
+
+bool Rewrite::runKernelsConcurrently(CXXMemberCallExpr *E) {
+  if (compilerOptions.emitOpenCL())
+    return launchKernelsAsync(E);
+
+  SmallVector<CXXMemberCallExpr *, 8> calls = ConcurrentCandidates[E];
+
+  auto get_kernel = [&] (CXXMemberCallExpr *E) -> HipaccKernel * {
+    auto DRE = cast<DeclRefExpr>(E->getImplicitObjectArgument()->
+        IgnoreParenCasts());
+    return KernelDeclMap.count(DRE->getDecl()) ?
+      KernelDeclMap[DRE->getDecl()] : nullptr;
+  };
+
+  // Kernels can run concurrently as long as none of them reads or writes an
+  // image written by another kernel of the group. Kernels reading their own
+  // output image are processed in bands of rows and are not grouped.
+  SmallVector<HipaccKernel *, 8> kernels;
+  llvm::SmallPtrSet<HipaccImage *, 16> written, read;
+  size_t num_calls = 0;
+  for (size_t i=0; i<calls.size(); ++i) {
+    HipaccKernel *K = get_kernel(calls[i]);
+    if (!K || K->getFusedConsumer()) break;
+
+    bool valid = true;
+    SmallVector<HipaccImage *, 4> outputs;
+    SmallVector<HipaccImage *, 8> inputs;
+    for (HipaccKernel *FK = K; FK; FK = FK->getFusedProducer()) {
+      HipaccIterationSpace *IS = FK->getIterationSpace();
+      outputs.push_back(IS->getImage());
+
+      for (auto img : FK->getKernelClass()->getImgFields()) {
+        HipaccAccessor *Acc = FK->getImgFromMapping(img);
+        if (Acc->isIterationSpace()) continue;
+
+        HipaccImage *Img = Acc->getImage();
+        if (Img == IS->getImage() || written.count(Img))
+          valid = false;
+        inputs.push_back(Img);
+      }
+    }
+    for (auto Img : outputs) {
+      if (written.count(Img) || read.count(Img))
+        valid = false;
+    }
+    if (!valid) break;
+
+    written.insert(outputs.begin(), outputs.end());
+    read.insert(inputs.begin(), inputs.end());
+    kernels.push_back(K);
+    num_calls = i + 1;
+  }
+
+  if (kernels.size() < 2) {
+    num_calls = 1;
+  }
+  // the remaining kernels may run concurrently on their own
+  if (calls.size() - num_calls > 1) {
+    ConcurrentCandidates[calls[num_calls]] =
+      SmallVector<CXXMemberCallExpr *, 8>(calls.begin() + num_calls,
+          calls.end());
+  }
+  if (kernels.size() < 2) return false;
+
+  // set host argument names and retrieve literals stored to temporaries
+  std::string newStr;
+  for (size_t i=0; i<num_calls; ++i) {
+    HipaccKernel *K = kernels[i];
+    CXXConstructExpr *CCE = dyn_cast<CXXConstructExpr>(K->getDecl()->getInit());
+    K->setHostArgNames(llvm::makeArrayRef(CCE->getArgs(),
+          CCE->getNumArgs()), newStr, literalCount);
+    if (i) ConcurrentCalls.insert(calls[i]);
+  }
+
+  stringCreator.writeConcurrentKernelCalls(kernels, newStr);
+
+  // replace the first kernel invocation by the concurrent invocations
+  SourceLocation startLoc = E->getLocStart();
+  const char *startBuf = SM.getCharacterData(startLoc);
+  const char *semiPtr = strchr(startBuf, ';');
+  TextRewriter.ReplaceText(startLoc, semiPtr-startBuf+1, newStr);
+
+  return true;
+}
+
+
+bool Rewrite::launchKernelsAsync(CXXMemberCallExpr *E) {
+  SmallVector<CXXMemberCallExpr *, 8> calls = ConcurrentCandidates[E];
+
+  // OpenCL kernels of the sequence are launched on separate command queues
+  // and wait only for the kernels of the sequence they depend on. Kernels
+  // executed more than once are not launched asynchronously.
+  SmallVector<HipaccKernel *, 8> kernels;
+  std::vector<std::vector<unsigned>> deps;
+  std::vector<ValueDecl *> decls;
+  for (auto call : calls) {
+    ValueDecl *VD = cast<DeclRefExpr>(call->getImplicitObjectArgument()->
+        IgnoreParenCasts())->getDecl();
+    std::vector<ValueDecl *> kernelDeps;
+    if (!KernelDeclMap.count(VD) ||
+        !dataDeps->getDependencies(VD, kernelDeps))
+      break;
+
+    std::vector<unsigned> waits;
+    for (auto dep : kernelDeps) {
+      auto it = std::find(decls.begin(), decls.end(), dep);
+      if (it != decls.end())
+        waits.push_back(it - decls.begin());
+    }
+    decls.push_back(VD);
+    kernels.push_back(KernelDeclMap[VD]);
+    deps.push_back(waits);
+  }
+
+  size_t num_calls = kernels.size() < 2 ? 1 : kernels.size();
+  // the remaining kernels may be launched asynchronously on their own
+  if (calls.size() - num_calls > 1) {
+    ConcurrentCandidates[calls[num_calls]] =
+      SmallVector<CXXMemberCallExpr *, 8>(calls.begin() + num_calls,
+          calls.end());
+  }
+  if (kernels.size() < 2) return false;
+
+  // set host argument names and retrieve literals stored to temporaries
+  std::string newStr;
+  for (size_t i=0; i<num_calls; ++i) {
+    HipaccKernel *K = kernels[i];
+    CXXConstructExpr *CCE = dyn_cast<CXXConstructExpr>(K->getDecl()->getInit());
+    K->setHostArgNames(llvm::makeArrayRef(CCE->getArgs(),
+          CCE->getNumArgs()), newStr, literalCount);
+    if (i) ConcurrentCalls.insert(calls[i]);
+  }
+
+  stringCreator.writeAsyncKernelCalls(kernels, deps, newStr);
+
+  // replace the first kernel invocation by the asynchronous launches
+  SourceLocation startLoc = E->getLocStart();
+  const char *startBuf = SM.getCharacterData(startLoc);
+  const char *semiPtr = strchr(startBuf, ';');
+  TextRewriter.ReplaceText(startLoc, semiPtr-startBuf+1, newStr);
+
+  return true;
+}
+
+
+bool Rewrite::isFusible(HipaccKernelClass *KC, HipaccKernel *K) {
+  // only point operators reading and writing the same pixel can be fused
+  if (KC->getKernelType() != PointOperator || KC->getReduceFunction() ||
+      KC->getBinningFunction())
+    return false;
+
+  if (K->getIterationSpace()->isCrop())
+    return false;
+
+  for (auto img : KC->getImgFields()) {
+    HipaccAccessor *Acc = K->getImgFromMapping(img);
+    if (Acc->isCrop() || Acc->getInterpolationMode() != Interpolate::NO)
+      return false;
   }
 
   return true;
@@ -1942,6 +2405,27 @@ bool Rewrite::VisitCXXMemberCallExpr(CXXMemberCallExpr *E) {
         E->getDirectCallee()->getNameAsString() == "execute") {
       // get the user Kernel class
       if (KernelDeclMap.count(DRE->getDecl())) {
+        // kernels streamed together with a previous kernel
+        if (StreamedCalls.count(E)) {
+          SourceLocation startLoc = E->getLocStart();
+          const char *startBuf = SM.getCharacterData(startLoc);
+          const char *semiPtr = strchr(startBuf, ';');
+          TextRewriter.RemoveText(startLoc, semiPtr-startBuf+1);
+          return true;
+        }
+        if (StreamCandidates.count(E) && streamKernels(E))
+          return true;
+        // kernels executed concurrently with a previous kernel
+        if (ConcurrentCalls.count(E)) {
+          SourceLocation startLoc = E->getLocStart();
+          const char *startBuf = SM.getCharacterData(startLoc);
+          const char *semiPtr = strchr(startBuf, ';');
+          TextRewriter.RemoveText(startLoc, semiPtr-startBuf+1);
+          return true;
+        }
+        if (ConcurrentCandidates.count(E) && runKernelsConcurrently(E))
+          return true;
+
         HipaccKernel *K = KernelDeclMap[DRE->getDecl()];
         VarDecl *VD = K->getDecl();
         std::string newStr;
@@ -1955,6 +2439,20 @@ bool Rewrite::VisitCXXMemberCallExpr(CXXMemberCallExpr *E) {
         K->setHostArgNames(llvm::makeArrayRef(CCE->getArgs(),
               CCE->getNumArgs()), newStr, literalCount);
 
+        // kernel is computed within the kernel it was fused into
+        if (compilerOptions.emitC99() && K->getFusedConsumer()) {
+          newStr += "// " + K->getKernelName() + " fused into " +
+            K->getFusedConsumer()->getKernelName() + "\n";
+          newStr += stringCreator.getIndent();
+
+          SourceLocation startLoc = E->getLocStart();
+          const char *startBuf = SM.getCharacterData(startLoc);
+          const char *semiPtr = strchr(startBuf, ';');
+          TextRewriter.ReplaceText(startLoc, semiPtr-startBuf+1, newStr);
+
+          return true;
+        }
+
         bool isOutputProcess = false;
         if (compilerOptions.emitOpenCLFPGA()) {
           //Get Kernel Name
@@ -2435,13 +2933,16 @@ void Rewrite::printReductionFunction(HipaccKernelClass *KC, HipaccKernel *K,
   FunctionDecl *fun = KC->getReduceFunction();
 
   // preprocessor defines
-  if (!compilerOptions.exploreConfig()) {
+  if (!compilerOptions.exploreConfig() || compilerOptions.emitC99()) {
     OS << "#define BS " << K->getNumThreadsReduce() << "\n"
        << "#define PPT " << K->getPixelsPerThreadReduce() << "\n";
   }
   if (K->getIterationSpace()->isCrop()) {
     OS << "#define USE_OFFSETS\n";
   }
+  if (compilerOptions.emitC99() && compilerOptions.useMultiThreading()) {
+    OS << "#define CPU_THREADS " << compilerOptions.getCPUThreads() << "\n";
+  }
   switch (compilerOptions.getTargetLang()) {
     case Language::Vivado:
       OS << "#include \"hipacc_vivado_red.hpp\"\n\n";
@@ -2616,6 +3117,49 @@ void Rewrite::printReductionFunction(HipaccKernelClass *KC, HipaccKernel *K,
 }
 
 
+// prints a loop for (int idx=lower; idx<upper; idx+=step) body as
+//
+// hipaccParallelFor(threads, lower, upper, step, [&] (int _lower, int _upper) {
+//     for (int idx=_lower; idx<_upper; idx+=step) body
+// });
+//
+// kernels with irregular work per pixel use the work-stealing scheduler
+// hipaccParallelForStealing() instead of static partitioning; kernels explored
+// or tuned at run time get the number of threads as parameter _cpu_threads
+void Rewrite::printParallelLoop(ForStmt *S, HipaccKernel *K,
+    PrinterHelper *Helper, PrintingPolicy &Policy, llvm::raw_ostream &OS) {
+  VarDecl *idx = cast<VarDecl>(cast<DeclStmt>(S->getInit())->getSingleDecl());
+  BinaryOperator *cond = cast<BinaryOperator>(S->getCond());
+
+  if (K->getKernelClass()->hasIrregularWork())
+    OS << "  hipaccParallelForStealing(";
+  else
+    OS << "  hipaccParallelFor(";
+  if (compilerOptions.useCPUConfigParams())
+    OS << "_cpu_threads, ";
+  else
+    OS << compilerOptions.getCPUThreads() << ", ";
+  idx->getInit()->printPretty(OS, 0, Policy);
+  OS << ", ";
+  cond->getRHS()->printPretty(OS, 0, Policy);
+  OS << ", ";
+  if (auto inc = dyn_cast<BinaryOperator>(S->getInc())) {
+    inc->getRHS()->printPretty(OS, 0, Policy);
+  } else {
+    OS << "1";
+  }
+  OS << ", [&] (int _lower, int _upper) {\n";
+
+  OS << "    for (int " << idx->getName() << " = _lower; " << idx->getName()
+     << " < _upper; ";
+  S->getInc()->printPretty(OS, 0, Policy);
+  OS << ")\n";
+  S->getBody()->printPretty(OS, Helper, Policy,
+      isa<CompoundStmt>(S->getBody()) ? 2 : 3);
+  OS << "  });\n";
+}
+
+
 void Rewrite::printKernelFunction(FunctionDecl *D, HipaccKernelClass *KC,
     HipaccKernel *K, std::string file, bool emitHints) {
   int fd;
@@ -2664,6 +3208,11 @@ void Rewrite::printKernelFunction(FunctionDecl *D, HipaccKernelClass *KC,
       break;
     case Language::Vivado:
       break;
+    case Language::C99:
+      // the order kernel files are included by the host is undefined
+      if (HipaccKernel *P = K->getFusedProducer())
+        OS << "#include \"" << P->getFileName() << ".cc\"\n\n";
+      break;
   }
 
   // declarations of textures, surfaces, variables, includes, definitions etc.
@@ -2876,6 +3425,18 @@ void Rewrite::printKernelFunction(FunctionDecl *D, HipaccKernelClass *KC,
     fun->print(OS, Policy);
   }
 
+  // per pixel function of kernels fused into their consumer
+  if (compilerOptions.emitC99() && PixelFunctionDeclMap.count(K)) {
+    OS << "static inline "
+       << (K->getFusedStore() ? "void" :
+           K->getIterationSpace()->getImage()->getTypeStr())
+       << " " << K->getPixelFunctionName() << "(";
+    printFusedArguments(K, "", OS);
+    OS << ", const int gid_x, const int gid_y) ";
+    PixelFunctionDeclMap[K]->getBody()->printPretty(OS, 0, Policy, 0);
+    OS << "\n";
+  }
+
   // write kernel name and qualifiers
   switch (compilerOptions.getTargetLang()) {
     case Language::C99:
@@ -2945,11 +3506,39 @@ void Rewrite::printKernelFunction(FunctionDecl *D, HipaccKernelClass *KC,
     OS << K->getKernelName();
     OS << "(";
     printKernelArguments(D, KC, K, Policy, OS);
+    if (compilerOptions.emitC99() && K->getFusedProducer()) {
+      OS << ", ";
+      printFusedArguments(K->getFusedProducer(),
+          K->getFusedProducer()->getName() + "_", OS);
+    }
+    if (compilerOptions.emitC99() && compilerOptions.useRowRanges())
+      OS << ", const int _stream_lower, const int _stream_upper";
+    if (compilerOptions.useCPUConfigParams())
+      OS << ", const int _cpu_threads, const int _cpu_tile_x, const int _cpu_tile_y";
     OS << ") ";
   }
 
   // print kernel body
-  D->getBody()->printPretty(OS, 0, Policy, 0);
+  SIMDLoopPrinterHelper SIMDHelper(K);
+  if (compilerOptions.emitC99() && (compilerOptions.useMultiThreading() ||
+                                    compilerOptions.useCPUConfigParams())) {
+    // distribute the outermost (gid_y) loops among the worker threads of the
+    // runtime; each thread processes one contiguous block of rows so that the
+    // rows of the accessor window are reused from cache by the same thread
+    OS << "{\n";
+    for (auto stmt : cast<CompoundStmt>(D->getBody())->body()) {
+      if (auto loop = dyn_cast<ForStmt>(stmt)) {
+        printParallelLoop(loop, K, &SIMDHelper, Policy, OS);
+      } else {
+        stmt->printPretty(OS, &SIMDHelper, Policy, 1);
+      }
+    }
+    OS << "}\n";
+  } else if (compilerOptions.emitC99()) {
+    D->getBody()->printPretty(OS, &SIMDHelper, Policy, 0);
+  } else {
+    D->getBody()->printPretty(OS, 0, Policy, 0);
+  }
   if (compilerOptions.emitCUDA()) {
     OS << "}\n";
   }
@@ -2962,6 +3551,21 @@ void Rewrite::printKernelFunction(FunctionDecl *D, HipaccKernelClass *KC,
     if (KC->getReduceFunction())
       printReductionFunction(KC, K, OS);
 
+    bool isVector = compilerOptions.getPixelsPerThread() > 1 ||
+      isa<VectorType>(K->getVivadoAccessor()->getImage()->getType().getCanonicalType().getTypePtr());
+    // split local operators with a single input into column-parallel lanes
+    bool useLanes = compilerOptions.getFPGALanes() > 1 &&
+      KC->getMaskFields().size() > 0 && KC->getImgFields().size() <= 2;
+    // local operators with a single input read by other kernels as well get
+    // their windows from a window generator shared with these kernels
+    std::string kernelName = K->getKernelName();
+    kernelName = kernelName.substr(2, kernelName.length()-8);
+    fpgaWindow = compilerOptions.shareWindows() && !isVector && !useLanes &&
+      KC->getMaskFields().size() > 0 &&
+      KC->getImgFields().size() == 2 &&
+      dataDeps->isSharedStream(kernelName,
+          K->getVivadoAccessor()->getImage()->getName());
+
     OS << "void " << K->getKernelName() << "(";
     printKernelArguments(D, KC, K, Policy, OS, Rewrite::Entry);
     OS << ", int IS_width, int IS_height) {\n";
@@ -2979,7 +3583,9 @@ void Rewrite::printKernelFunction(FunctionDecl *D, HipaccKernelClass *KC,
     printKernelArguments(D, KC, K, Policy, OS, Rewrite::KernelInit);
     OS << ";\n";
 
-    if (KC->getMaskFields().size() > 0) {
+    if (useLanes) {
+      OS << "    processLanes";
+    } else if (KC->getMaskFields().size() > 0) {
       OS << "    process";
       if (KC->getImgFields().size() > 2) {
         OS << "MISO";
@@ -2990,8 +3596,7 @@ void Rewrite::printKernelFunction(FunctionDecl *D, HipaccKernelClass *KC,
         OS << KC->getImgFields().size()-1;
       }
     }
-    if (compilerOptions.getPixelsPerThread() > 1 ||
-        isa<VectorType>(K->getVivadoAccessor()->getImage()->getType().getCanonicalType().getTypePtr())) {
+    if (isVector) {
       OS << "VECT";
       if (K->getVivadoAccessor()->getImage()->getType()->isRealFloatingType()) {
         OS << "F";
@@ -2999,12 +3604,15 @@ void Rewrite::printKernelFunction(FunctionDecl *D, HipaccKernelClass *KC,
     }
     OS << "<HIPACC_II_TARGET,HIPACC_MAX_WIDTH,HIPACC_MAX_HEIGHT";
     OS << "," << vivadoSizeX << "," << vivadoSizeY;
-    if (compilerOptions.getPixelsPerThread() > 1 ||
-        isa<VectorType>(K->getVivadoAccessor()->getImage()->getType().getCanonicalType().getTypePtr())) {
+    if (useLanes) {
+      OS << ",HIPACC_LANES";
+    }
+    if (isVector) {
       OS << ",HIPACC_PPT";
       OS << "," << K->getVivadoAccessor()->getImage()->getTypeStr() << " ";
     }
     OS << ">(";
+    fpgaBorders.clear();
     printKernelArguments(D, KC, K, Policy, OS, Rewrite::KernelCall);
     if (KC->getReduceFunction()) {
       OS << ", _str4red";
@@ -3015,19 +3623,54 @@ void Rewrite::printKernelFunction(FunctionDecl *D, HipaccKernelClass *KC,
        << ", IS_height"
        << ", kernel";
     if (KC->getMaskFields().size() > 0) {
-      switch (fpgaBM) {
-        case clang::hipacc::Boundary::UNDEFINED:
-          OS << ", BorderPadding::BORDER_UNDEF";
-          break;
-        case clang::hipacc::Boundary::CLAMP:
-          OS << ", BorderPadding::BORDER_CLAMP";
-          break;
-        case clang::hipacc::Boundary::MIRROR:
-          OS << ", BorderPadding::BORDER_MIRROR";
-          break;
-        default:
-          assert(false && "Chosen BoundaryCondition not supported for Vivado");
-          break;
+      auto print_border = [&] (std::pair<Boundary, Expr *> border,
+          bool withValue, llvm::raw_ostream &BS) {
+        switch (border.first) {
+          case clang::hipacc::Boundary::UNDEFINED:
+            BS << ", BorderPadding::BORDER_UNDEF";
+            break;
+          case clang::hipacc::Boundary::CLAMP:
+            BS << ", BorderPadding::BORDER_CLAMP";
+            break;
+          case clang::hipacc::Boundary::MIRROR:
+            BS << ", BorderPadding::BORDER_MIRROR";
+            break;
+          case clang::hipacc::Boundary::MIRROR_101:
+            BS << ", BorderPadding::BORDER_MIRROR_101";
+            break;
+          case clang::hipacc::Boundary::CONSTANT:
+            BS << ", BorderPadding::BORDER_CONST, ";
+            border.second->printPretty(BS, 0, Policy, 0);
+            return;
+          default:
+            assert(false && "Chosen BoundaryCondition not supported for Vivado");
+            break;
+        }
+        if (withValue) BS << ", 0";
+      };
+
+      // MISO operators handle the border of each input on its own, unless
+      // all inputs use the same border handling
+      bool sameBorders = true;
+      for (auto border : fpgaBorders) {
+        if (border.first != fpgaBorders.front().first ||
+            border.second != fpgaBorders.front().second)
+          sameBorders = false;
+      }
+
+      std::string border;
+      llvm::raw_string_ostream BS(border);
+      if (sameBorders) {
+        print_border(fpgaBorders.front(), false, BS);
+      } else {
+        for (auto border : fpgaBorders)
+          print_border(border, true, BS);
+      }
+      OS << BS.str();
+      // the window generator handles the border, see HostDataDeps
+      if (fpgaWindow) {
+        dataDeps->addSharedWindow(kernelName, vivadoSizeX, vivadoSizeY,
+            BS.str());
       }
     }
     OS << ");\n";
@@ -3106,6 +3749,7 @@ void Rewrite::printKernelFunction(FunctionDecl *D, HipaccKernelClass *KC,
     OS << ", ";
 
     // handle input channels/arrays
+    fpgaBorders.clear();
     printKernelArguments(D, KC, K, Policy, OS, Rewrite::KernelCall);
 
     OS << ", HIPACC_MAX_WIDTH, HIPACC_MAX_HEIGHT";
@@ -3113,7 +3757,7 @@ void Rewrite::printKernelFunction(FunctionDecl *D, HipaccKernelClass *KC,
     if (KC->getMaskFields().size() > 0) {
     OS << ", " << K->getLocalWindow()->getSizeX();
     OS << ", " << K->getLocalWindow()->getSizeY();
-      switch (fpgaBM) {
+      switch (fpgaBorders.back().first) {
         case clang::hipacc::Boundary::CLAMP:
           OS << ", CLAMP";
           break;
@@ -3123,8 +3767,12 @@ void Rewrite::printKernelFunction(FunctionDecl *D, HipaccKernelClass *KC,
         case clang::hipacc::Boundary::UNDEFINED:
           OS << ", UNDEFINED";
           break;
+        case clang::hipacc::Boundary::MIRROR_101:
+          OS << ", MIRROR_101";
+          break;
         case clang::hipacc::Boundary::CONSTANT:
-          OS << ", CONSTANT, 0";
+          OS << ", CONSTANT, ";
+          fpgaBorders.back().second->printPretty(OS, 0, Policy, 0);
           break;
         default:
           assert(false && "Chosen BoundaryCondition not supported for Altera OpenCL");
@@ -3152,6 +3800,8 @@ void Rewrite::printKernelFunction(FunctionDecl *D, HipaccKernelClass *KC,
 #endif
   close(fd);
 
+  // the entry is rewritten after each kernel, the last one includes the
+  // shared windows registered by all kernels
   if (compilerOptions.emitVivado() || compilerOptions.emitOpenCLFPGA()) {
     createFPGAEntry();
   }
@@ -3344,7 +3994,8 @@ void Rewrite::printKernelArguments(FunctionDecl *D, HipaccKernelClass *KC,
                   OS << ", ARRY";
                 }
               }
-              fpgaBM = Acc->getBoundaryMode();
+              fpgaBorders.push_back({ Acc->getBoundaryMode(),
+                  Acc->getConstExpr() });
             break;
             default:
               /* nothing to do */
@@ -3365,14 +4016,23 @@ void Rewrite::printKernelArguments(FunctionDecl *D, HipaccKernelClass *KC,
               break;
               case Rewrite::PrintParam::Entry:
                 if (comma++) OS << ", ";
-                OS << "hls::stream<" << createVivadoTypeStr(Acc->getImage(),
-                    compilerOptions.getPixelsPerThread()) << " > &"
-                    << Name;
+                if (fpgaWindow) {
+                  // same pixel type as the stream copies in HostDataDeps
+                  OS << "hls::stream<StreamWindow<" << vivadoSizeX << ","
+                     << vivadoSizeY << "," << createVivadoTypeStr(
+                         Acc->getImage(), compilerOptions.getPixelsPerThread())
+                     << " > > &" << Name;
+                } else {
+                  OS << "hls::stream<" << createVivadoTypeStr(Acc->getImage(),
+                      compilerOptions.getPixelsPerThread()) << " > &"
+                      << Name;
+                }
               break;
               case Rewrite::PrintParam::KernelCall:
                 if (comma++) OS << ", ";
                 OS << Name;
-                fpgaBM = Acc->getBoundaryMode();
+                fpgaBorders.push_back({ Acc->getBoundaryMode(),
+                    Acc->getConstExpr() });
               break;
               default:
                 /* nothing to do */
@@ -3486,5 +4146,41 @@ void Rewrite::printKernelArguments(FunctionDecl *D, HipaccKernelClass *KC,
   }
 }
 
+
+void Rewrite::printFusedArguments(HipaccKernel *K, std::string prefix,
+    llvm::raw_ostream &OS) {
+  SmallVector<HipaccKernel::FusedArg, 16> fusedArgs;
+  K->getFusedArgs(prefix, fusedArgs);
+
+  size_t comma = 0;
+  for (auto arg : fusedArgs) {
+    FieldDecl *FD = arg.K->getDeviceArgFields()[arg.idx];
+    if (comma++)
+      OS << ", ";
+
+    if (auto Mask = arg.K->getMaskFromMapping(FD)) {
+      OS << "const "
+         << Mask->getTypeStr()
+         << " " << arg.name
+         << "[" << Mask->getSizeYStr() << "]"
+         << "[" << Mask->getSizeXStr() << "]";
+    } else if (auto Acc = arg.K->getImgFromMapping(FD)) {
+      if (arg.K->getKernelClass()->getMemAccess(FD) == READ_ONLY)
+        OS << "const ";
+      OS << Acc->getImage()->getTypeStr()
+         << " " << arg.name
+         << "[" << Acc->getImage()->getSizeYStr() << "]"
+         << "[" << Acc->getImage()->getSizeXStr() << "]";
+    } else {
+      QualType T = arg.K->getArgTypes()[arg.idx];
+      T.removeLocalConst();
+      T.removeLocalRestrict();
+      std::string Name(arg.name);
+      T.getAsStringInternal(Name, Policy);
+      OS << Name;
+    }
+  }
+}
+
 // vim: set ts=2 sw=2 sts=2 et ai:
 
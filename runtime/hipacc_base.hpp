@@ -27,12 +27,16 @@
 #define __HIPACC_BASE_HPP__
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <cstdint>
 #include <functional>
 #include <list>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <string>
 #include <vector>
 #include <algorithm>
 
@@ -66,11 +70,14 @@ class HipaccImageBase {
         void *mem;
         hipaccMemoryType mem_type;
         char *host;
+        bool own_host;
 
     public:
+        // host memory is allocated unless provided, e.g. in case the memory
+        // of the image is accessible by the host
         HipaccImageBase(size_t width, size_t height, size_t stride,
                     size_t alignment, size_t pixel_size, void *mem,
-                    hipaccMemoryType mem_type=Global);
+                    hipaccMemoryType mem_type=Global, char *host=nullptr);
 
         ~HipaccImageBase();
 
@@ -122,6 +129,56 @@ typedef struct hipacc_smem_info {
 } hipacc_smem_info;
 
 
+#ifndef VIVADO_SYNTHESIS
+// Kernel launch recorded by the profiler, times in microseconds
+struct HipaccProfileEvent {
+    const char *kernel;
+    int64_t start, end;
+    int width, height;
+    size_t bytes_read, bytes_written;
+    int thread;
+};
+
+// The profiler records kernel launches in a lock-free ring buffer holding the
+// last HIPACC_PROFILE_EVENTS launches (65536 unless defined otherwise), which
+// is allocated at the first launch. In case the environment variable
+// HIPACC_PROFILE names a file, a Chrome trace of the launches is written to
+// the file at exit (see chrome://tracing) and a summary per kernel is printed.
+class HipaccProfiler {
+    private:
+        struct Slot {
+            std::atomic<uint64_t> seq;
+            HipaccProfileEvent event;
+        };
+        std::unique_ptr<Slot[]> slots;
+        std::once_flag allocated;
+        std::atomic<uint64_t> next;
+
+        HipaccProfiler();
+        HipaccProfiler(HipaccProfiler const &);
+        void operator=(HipaccProfiler const &);
+        Slot *getSlots();
+
+    public:
+        static HipaccProfiler &getInstance();
+        ~HipaccProfiler();
+        // kernel names are not copied and have to be string literals or
+        // names kept by hipaccProfileName()
+        void record(const HipaccProfileEvent &event);
+        // recorded launches ordered by start time
+        std::vector<HipaccProfileEvent> getEvents();
+        void writeTrace(const std::string &filename);
+        void printSummary();
+};
+
+int hipaccThreadId();
+void hipaccProfileKernel(const char *kernel, int64_t start, int64_t end,
+                         int width, int height, size_t bytes_read,
+                         size_t bytes_written);
+const char *hipaccProfileName(const std::string &kernel);
+#endif // VIVADO_SYNTHESIS
+
+
 class HipaccPyramid {
   public:
     const int depth_;
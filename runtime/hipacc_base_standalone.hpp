@@ -34,6 +34,12 @@
 #define __HIPACC_BASE_STANDALONE_HPP__
 
 
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+
 float last_gpu_timing = 0.0f;
 
 // get GPU timing of last executed Kernel in ms
@@ -53,6 +59,193 @@ int64_t hipacc_time_micro() {
 }
 
 
+#ifndef VIVADO_SYNTHESIS
+// number of kernel launches kept by the profiler, a power of two
+#ifndef HIPACC_PROFILE_EVENTS
+#define HIPACC_PROFILE_EVENTS (1 << 16)
+#endif
+
+HipaccProfiler &HipaccProfiler::getInstance() {
+    static HipaccProfiler instance;
+
+    return instance;
+}
+
+HipaccProfiler::HipaccProfiler() : next(0) {
+}
+
+HipaccProfiler::Slot *HipaccProfiler::getSlots() {
+    std::call_once(allocated, [&] {
+        slots.reset(new Slot[HIPACC_PROFILE_EVENTS]);
+        for (size_t i=0; i<HIPACC_PROFILE_EVENTS; ++i)
+            slots[i].seq.store(0, std::memory_order_relaxed);
+    });
+
+    return slots.get();
+}
+
+HipaccProfiler::~HipaccProfiler() {
+    const char *filename = std::getenv("HIPACC_PROFILE");
+    if (filename && *filename) {
+        writeTrace(filename);
+        printSummary();
+    }
+}
+
+// each slot is guarded by a sequence number: odd while the launch n is
+// written, 2n+2 once it is complete
+void HipaccProfiler::record(const HipaccProfileEvent &event) {
+    uint64_t n = next.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = getSlots()[n % HIPACC_PROFILE_EVENTS];
+
+    // claim the slot; in case the ring wrapped around and another launch is
+    // written to the slot or a newer one completed, this launch is dropped
+    uint64_t seq = slot.seq.load(std::memory_order_relaxed);
+    do {
+        if ((seq & 1) || seq > 2*n) return;
+    } while (!slot.seq.compare_exchange_weak(seq, 2*n + 1,
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed));
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.event = event;
+    slot.seq.store(2*n + 2, std::memory_order_release);
+}
+
+std::vector<HipaccProfileEvent> HipaccProfiler::getEvents() {
+    std::vector<HipaccProfileEvent> events;
+    uint64_t last = next.load(std::memory_order_acquire);
+    uint64_t first = last > HIPACC_PROFILE_EVENTS ?
+                     last - HIPACC_PROFILE_EVENTS : 0;
+
+    for (uint64_t n=first; n<last; ++n) {
+        Slot &slot = getSlots()[n % HIPACC_PROFILE_EVENTS];
+        uint64_t seq = slot.seq.load(std::memory_order_acquire);
+        if (seq != 2*n + 2) continue;
+        HipaccProfileEvent event = slot.event;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // skip launches overwritten while reading
+        if (slot.seq.load(std::memory_order_relaxed) != seq) continue;
+        events.push_back(event);
+    }
+
+    std::sort(events.begin(), events.end(),
+              [] (const HipaccProfileEvent &a, const HipaccProfileEvent &b) {
+                  return a.start < b.start;
+              });
+    return events;
+}
+
+// Chrome trace event format: one complete event ("ph": "X") per launch
+void HipaccProfiler::writeTrace(const std::string &filename) {
+    std::vector<HipaccProfileEvent> events = getEvents();
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "ERROR: Could not write profile to '" << filename << "'"
+                  << std::endl;
+        return;
+    }
+
+    int64_t origin = events.empty() ? 0 : events.front().start;
+    file << "{\"traceEvents\": [";
+    for (size_t i=0; i<events.size(); ++i) {
+        const HipaccProfileEvent &e = events[i];
+        file << (i ? ",\n" : "\n")
+             << "  {\"name\": \"" << e.kernel << "\", \"cat\": \"kernel\", "
+             << "\"ph\": \"X\", \"pid\": 0, \"tid\": " << e.thread << ", "
+             << "\"ts\": " << e.start - origin << ", "
+             << "\"dur\": " << e.end - e.start << ", "
+             << "\"args\": {\"width\": " << e.width << ", "
+             << "\"height\": " << e.height << ", "
+             << "\"bytes_read\": " << e.bytes_read << ", "
+             << "\"bytes_written\": " << e.bytes_written << "}}";
+    }
+    file << "\n], \"displayTimeUnit\": \"ms\"}" << std::endl;
+}
+
+// launches, total, median, 99th percentile, and maximum time per kernel;
+// throughput and bandwidth refer to the median launch
+void HipaccProfiler::printSummary() {
+    std::vector<HipaccProfileEvent> events = getEvents();
+    std::vector<std::string> kernels;
+    std::vector<std::vector<HipaccProfileEvent>> launches;
+    int64_t total = 0;
+
+    for (auto &e : events) {
+        size_t k = std::find(kernels.begin(), kernels.end(), e.kernel) -
+                   kernels.begin();
+        if (k == kernels.size()) {
+            kernels.push_back(e.kernel);
+            launches.emplace_back();
+        }
+        launches[k].push_back(e);
+        total += e.end - e.start;
+    }
+
+    std::cerr << "<HIPACC:> Profile of " << events.size() << " launches:"
+              << std::endl << "<HIPACC:> " << std::left << std::setw(32)
+              << "kernel" << std::right << std::setw(9) << "launches"
+              << std::setw(12) << "total(ms)" << std::setw(10) << "p50(ms)"
+              << std::setw(10) << "p99(ms)" << std::setw(10) << "max(ms)"
+              << std::setw(11) << "Mpixel/s" << std::setw(9) << "GB/s"
+              << std::setw(8) << "share" << std::endl;
+
+    for (size_t k=0; k<kernels.size(); ++k) {
+        std::vector<HipaccProfileEvent> &l = launches[k];
+        std::sort(l.begin(), l.end(),
+                  [] (const HipaccProfileEvent &a, const HipaccProfileEvent &b) {
+                      return a.end - a.start < b.end - b.start;
+                  });
+        int64_t sum = 0;
+        for (auto &e : l) sum += e.end - e.start;
+        // nearest rank percentiles
+        const HipaccProfileEvent &p50 = l[(l.size() + 1)/2 - 1];
+        const HipaccProfileEvent &p99 = l[(99*l.size() + 99)/100 - 1];
+        float p50_us = std::max<int64_t>(1, p50.end - p50.start);
+
+        std::cerr << "<HIPACC:> " << std::left << std::setw(32) << kernels[k]
+                  << std::right << std::setw(9) << l.size()
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(12) << sum * 1.0e-3f
+                  << std::setw(10) << (p50.end - p50.start) * 1.0e-3f
+                  << std::setw(10) << (p99.end - p99.start) * 1.0e-3f
+                  << std::setw(10) << (l.back().end - l.back().start) * 1.0e-3f
+                  << std::setprecision(1)
+                  << std::setw(11) << (float)p50.width * p50.height / p50_us
+                  << std::setprecision(2) << std::setw(9)
+                  << (p50.bytes_read + p50.bytes_written) * 1.0e-3f / p50_us
+                  << std::setprecision(1) << std::setw(7)
+                  << (total ? 100.0f * sum / total : 0.0f) << "%"
+                  << std::endl;
+    }
+}
+
+// small sequential ids instead of std::thread::id for the trace
+int hipaccThreadId() {
+    static std::atomic<int> num_threads(0);
+    static thread_local int id = num_threads++;
+
+    return id;
+}
+
+void hipaccProfileKernel(const char *kernel, int64_t start, int64_t end,
+                         int width, int height, size_t bytes_read,
+                         size_t bytes_written) {
+    HipaccProfiler::getInstance().record({ kernel, start, end, width, height,
+        bytes_read, bytes_written, hipaccThreadId() });
+}
+
+// names of kernels known only at runtime are kept for the profiler, which does
+// not copy them; the names are leaked, since the profiler reports at exit
+const char *hipaccProfileName(const std::string &kernel) {
+    static std::mutex mutex;
+    static std::set<std::string> *names = new std::set<std::string>;
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return names->insert(kernel).first->c_str();
+}
+#endif // VIVADO_SYNTHESIS
+
+
 unsigned int nextPow2(unsigned int x) {
     --x;
     x |= x >> 1;
@@ -70,15 +263,19 @@ unsigned int nextPow2(unsigned int x) {
 
 
 HipaccImageBase::HipaccImageBase(size_t width, size_t height, size_t stride,
-    size_t alignment, size_t pixel_size, void *mem, hipaccMemoryType mem_type)
+    size_t alignment, size_t pixel_size, void *mem, hipaccMemoryType mem_type,
+    char *host)
     : width(width), height(height), stride(stride), alignment(alignment),
       pixel_size(pixel_size), mem(mem), mem_type(mem_type),
-      host(new char[width*height*pixel_size]) {
-    std::fill(host, host + width*height*pixel_size, 0);
+      host(host ? host : new char[width*height*pixel_size]),
+      own_host(host == nullptr) {
+    if (own_host)
+        std::fill(this->host, this->host + width*height*pixel_size, 0);
 }
 
 HipaccImageBase::~HipaccImageBase() {
-    delete[] host;
+    if (own_host)
+        delete[] host;
 }
 
 bool HipaccImageBase::operator==(const HipaccImageBase &other) const {
@@ -81,6 +81,8 @@ class HipaccContext : public HipaccContextBase {
         std::vector<cl_device_id> devices, devices_all;
         std::vector<cl_context> contexts;
         std::map<int, std::vector<cl_command_queue> > queues;
+        std::vector<cl_command_queue> async_queues;
+        std::map<cl_event, HipaccProfileEvent> async_launches;
         std::map<std::string, cl_program> programs;
 
     public:
@@ -99,6 +101,10 @@ class HipaccContext : public HipaccContextBase {
         std::vector<cl_device_id> get_devices_all();
         std::vector<cl_context> get_contexts();
         std::vector<cl_command_queue> get_command_queues(int num_kernel=0);
+        cl_command_queue get_async_queue(size_t num_queue);
+        // kernel and work size of asynchronous launches for the profiler
+        void add_async_launch(cl_event event, HipaccProfileEvent launch);
+        HipaccProfileEvent take_async_launch(cl_event event);
         cl_program get_program(std::string filename);
 };
 
@@ -125,10 +131,13 @@ cl_sampler hipaccCreateSampler(cl_bool normalized_coords, cl_addressing_mode add
 void hipaccCopyMemory(const HipaccImage &src, HipaccImage &dst, int num_device=0);
 void hipaccCopyMemoryRegion(const HipaccAccessor &src, const HipaccAccessor &dst, int num_device=0);
 double hipaccCopyBufferBenchmark(const HipaccImage &src, HipaccImage &dst, int num_device=0, bool print_timing=false);
+const char *hipaccGetKernelName(cl_kernel kernel);
 void hipaccLaunchKernel(cl_kernel kernel, size_t *global_work_size, size_t *local_work_size, int num_kernel=0, bool print_timing=true);
 #ifdef ALTERACL
 void hipaccFinish(int num_kernel=0)
 #endif
+void hipaccLaunchKernelAsync(cl_kernel kernel, size_t *global_work_size, size_t *local_work_size, size_t num_queue, std::vector<cl_event> wait_list, cl_event *event);
+void hipaccFinishAsync(std::vector<cl_event> &events, bool print_timing=true);
 void hipaccLaunchKernelBenchmark(cl_kernel kernel, size_t *global_work_size, size_t *local_work_size, std::vector<std::pair<size_t, void *> > args, bool print_timing=true);
 void hipaccLaunchKernelExploration(std::string filename, std::string kernel,
         std::vector<std::pair<size_t, void *> > args,
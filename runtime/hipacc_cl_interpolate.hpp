@@ -74,6 +74,18 @@ inline int bh_mirror_upper(int idx, int upper) {
     return idx;
 }
 
+// border handling: MIRROR_101
+#define BH_MIRROR_101_LOWER(idx, lower, upper) bh_mirror_101_lower(idx, lower)
+#define BH_MIRROR_101_UPPER(idx, lower, upper) bh_mirror_101_upper(idx, upper)
+inline int bh_mirror_101_lower(int idx, int lower) {
+    if (idx  < lower) idx = lower + (lower - idx);
+    return idx;
+}
+inline int bh_mirror_101_upper(int idx, int upper) {
+    if (idx >= upper) idx = upper - (idx+2 - upper);
+    return idx;
+}
+
 // border handling: CONSTANT
 #define BH_CONSTANT_LOWER(idx, lower, upper) bh_constant_lower(idx, lower)
 #define BH_CONSTANT_UPPER(idx, lower, upper) bh_constant_upper(idx, upper)
@@ -191,6 +191,35 @@ std::vector<cl_command_queue> HipaccContext::get_command_queues(int num_kernel)
     return queues[num_kernel];
 }
 
+// command queues for asynchronous kernel launches are created on demand
+cl_command_queue HipaccContext::get_async_queue(size_t num_queue) {
+    while (async_queues.size() <= num_queue) {
+        cl_int err = CL_SUCCESS;
+        cl_command_queue command_queue;
+        #ifdef CL_VERSION_2_0
+        cl_queue_properties cprops[3] = { CL_QUEUE_PROPERTIES, CL_QUEUE_PROFILING_ENABLE, 0 };
+        command_queue = clCreateCommandQueueWithProperties(contexts[0], devices[0], cprops, &err);
+        checkErr(err, "clCreateCommandQueueWithProperties()");
+        #else
+        command_queue = clCreateCommandQueue(contexts[0], devices[0], CL_QUEUE_PROFILING_ENABLE, &err);
+        checkErr(err, "clCreateCommandQueue()");
+        #endif
+        async_queues.push_back(command_queue);
+    }
+
+    return async_queues[num_queue];
+}
+
+void HipaccContext::add_async_launch(cl_event event, HipaccProfileEvent launch) {
+    async_launches[event] = launch;
+}
+
+HipaccProfileEvent HipaccContext::take_async_launch(cl_event event) {
+    HipaccProfileEvent launch = async_launches[event];
+    async_launches.erase(event);
+    return launch;
+}
+
 cl_program HipaccContext::get_program(std::string filename) {
     return programs[filename];
 }
@@ -749,6 +778,22 @@ double hipaccCopyBufferBenchmark(const HipaccImage &src, HipaccImage &dst, int n
 }
 
 
+// Get name of kernel for the profiler
+const char *hipaccGetKernelName(cl_kernel kernel) {
+    cl_int err;
+    size_t size = 0;
+
+    err = clGetKernelInfo(kernel, CL_KERNEL_FUNCTION_NAME, 0, NULL, &size);
+    std::string name(size, '\0');
+    err |= clGetKernelInfo(kernel, CL_KERNEL_FUNCTION_NAME, size, &name[0], NULL);
+    checkErr(err, "clGetKernelInfo()");
+    // strip the terminating null character
+    name.resize(size ? size-1 : 0);
+
+    return hipaccProfileName(name);
+}
+
+
 // Enqueue and launch kernel
 void hipaccLaunchKernel(cl_kernel kernel, size_t *global_work_size, size_t *local_work_size, int num_kernel, bool print_timing) {
     cl_int err;
@@ -803,6 +848,10 @@ void hipaccLaunchKernel(cl_kernel kernel, size_t *global_work_size, size_t *loca
 
 #ifndef ALTERACL
     last_gpu_timing = (end-start)*1.0e-3f;
+    // record the launch on the host clock, ending now
+    int64_t now = hipacc_time_micro();
+    hipaccProfileKernel(hipaccGetKernelName(kernel), now - (int64_t)(end-start), now,
+                        global_work_size[0], global_work_size[1], 0, 0);
     if (print_timing) {
         std::cerr << "<HIPACC:> Kernel timing (" << local_work_size[0]*local_work_size[1] << ": " << local_work_size[0] << "x" << local_work_size[1] << "): " << last_gpu_timing << "(ms)" << std::endl;
     }
@@ -820,6 +869,62 @@ void hipaccFinish(int num_kernel) {
 #endif
 
 
+// Enqueue kernel on the given command queue once the events of the wait list
+// are complete, without waiting for the kernel
+void hipaccLaunchKernelAsync(cl_kernel kernel, size_t *global_work_size, size_t *local_work_size, size_t num_queue, std::vector<cl_event> wait_list, cl_event *event) {
+    cl_int err;
+    HipaccContext &Ctx = HipaccContext::getInstance();
+    cl_command_queue queue = Ctx.get_async_queue(num_queue);
+
+    err = clEnqueueNDRangeKernel(queue, kernel, 2, NULL, global_work_size, local_work_size, wait_list.size(), wait_list.empty() ? NULL : wait_list.data(), event);
+    checkErr(err, "clEnqueueNDRangeKernel()");
+    Ctx.add_async_launch(*event, { hipaccGetKernelName(kernel), 0, 0,
+        (int)global_work_size[0], (int)global_work_size[1], 0, 0, 0 });
+    // submit the kernel, other queues may wait for its event
+    err = clFlush(queue);
+    checkErr(err, "clFlush()");
+}
+
+
+// Wait for kernels launched asynchronously and release their events; the
+// timing spans from the first kernel start to the last kernel end
+void hipaccFinishAsync(std::vector<cl_event> &events, bool print_timing) {
+    cl_int err;
+    cl_ulong end = 0, start = 0;
+    std::vector<cl_ulong> event_end(events.size()), event_start(events.size());
+    HipaccContext &Ctx = HipaccContext::getInstance();
+
+    err = clWaitForEvents(events.size(), events.data());
+    checkErr(err, "clWaitForEvents()");
+    for (size_t i=0; i<events.size(); ++i) {
+        err = clGetEventProfilingInfo(events[i], CL_PROFILING_COMMAND_END, sizeof(cl_ulong), &event_end[i], 0);
+        err |= clGetEventProfilingInfo(events[i], CL_PROFILING_COMMAND_START, sizeof(cl_ulong), &event_start[i], 0);
+        checkErr(err, "clGetEventProfilingInfo()");
+        if (i == 0 || event_start[i] < start) start = event_start[i];
+        if (i == 0 || event_end[i] > end) end = event_end[i];
+    }
+
+    // record the launches on the host clock, the last one ending now
+    int64_t now = hipacc_time_micro();
+    for (size_t i=0; i<events.size(); ++i) {
+        HipaccProfileEvent launch = Ctx.take_async_launch(events[i]);
+        hipaccProfileKernel(launch.kernel,
+                            now - (int64_t)(end-event_start[i])/1000,
+                            now - (int64_t)(end-event_end[i])/1000,
+                            launch.width, launch.height, 0, 0);
+
+        err = clReleaseEvent(events[i]);
+        checkErr(err, "clReleaseEvent()");
+    }
+
+    last_gpu_timing = (end-start)*1.0e-6f;
+    if (print_timing) {
+        std::cerr << "<HIPACC:> Kernel timing (" << events.size() << " concurrent kernels): " << last_gpu_timing << "(ms)" << std::endl;
+    }
+    events.clear();
+}
+
+
 // Benchmark timing for a kernel call
 void hipaccLaunchKernelBenchmark(cl_kernel kernel, size_t *global_work_size, size_t *local_work_size, std::vector<std::pair<size_t, void *> > args, bool print_timing) {
     std::vector<float> times;
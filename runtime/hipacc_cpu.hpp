@@ -26,35 +26,131 @@
 #ifndef __HIPACC_CPU_HPP__
 #define __HIPACC_CPU_HPP__
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <condition_variable>
 #include <cstring>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "hipacc_base.hpp"
 
+// The context owns a persistent pool of worker threads pinned to cores.
+// Worker threads are started on first use and wait for parallel regions
+// dispatched by run(); the calling thread takes part as thread 0.
 class HipaccContext : public HipaccContextBase {
+    private:
+        std::vector<std::thread> workers;
+        std::mutex mutex, dispatch_mutex;
+        std::condition_variable wakeup;
+        const std::function<void(int, int)> *task;
+        int task_threads;
+        std::atomic<unsigned> generation;
+        std::atomic<int> pending;
+        std::atomic<bool> shutdown;
+
+        HipaccContext();
+        void addWorkers(int num_threads);
+        void work(int tid);
+
     public:
         static HipaccContext &getInstance();
+        ~HipaccContext();
+        // number of threads used for a request of threads, 0 means all cores
+        int getNumThreads(int threads=0);
+        // calls fun(tid, num_threads) for each thread and returns when all
+        // threads are done; nested calls are executed by the calling thread
+        void run(int threads, const std::function<void(int, int)> &fun);
+};
+
+// Pool of page-aligned memory blocks; large blocks are aligned to and backed
+// by huge pages. Blocks of released images are recycled for new images of
+// the same size class, up to HIPACC_POOL_LIMIT bytes of free blocks. The pool
+// is never destroyed, so that images of static lifetime can be released
+// after exit() has started.
+class HipaccMemoryPool {
+    private:
+        std::mutex mutex;
+        std::map<size_t, std::vector<void *>> free_blocks;
+        size_t free_bytes;
+
+        HipaccMemoryPool() : free_bytes(0) {}
+        HipaccMemoryPool(HipaccMemoryPool const &);
+        void operator=(HipaccMemoryPool const &);
+        static size_t getSizeClass(size_t size);
+        static void freeBlock(void *mem);
+
+    public:
+        static HipaccMemoryPool &getInstance();
+        void *allocate(size_t size, size_t alignment);
+        void release(void *mem, size_t size);
+        // returns all free blocks to the system
+        void trim();
+};
+
+// Iterations [begin, end) of a loop owned by one thread of the work-stealing
+// scheduler; padded by a cache line, so that the ranges of two threads never
+// share one, independent of the alignment new[] provides before C++17
+struct HipaccWorkRange {
+    std::mutex mutex;
+    long begin, end;
+    char padding[64];
+};
+
+// Kernel invocation fun(lower, upper) processing rows [lower, upper) of an
+// iteration space of height rows
+struct HipaccTask {
+    int height;
+    std::function<void(int, int)> fun;
+
+    HipaccTask(int height, std::function<void(int, int)> fun)
+        : height(height), fun(fun) {}
+};
+
+// Number of threads and tile size of a kernel for images of width x height
+// pixels, explored by hipaccLaunchKernelExploration()
+struct HipaccCPUConfig {
+    int width, height;
+    int threads;
+    int tile_x, tile_y;
+
+    HipaccCPUConfig(int width, int height, int threads, int tile_x, int tile_y)
+        : width(width), height(height), threads(threads), tile_x(tile_x),
+          tile_y(tile_y) {}
 };
 
 class HipaccImageCPU : public HipaccImageBase {
     private:
         char *mem;
+        bool own_mem;
     public:
+        // images without padding use their memory as host memory; memory not
+        // owned by the image is provided by the caller and not freed
         HipaccImageCPU(size_t width, size_t height, size_t stride,
                        size_t alignment, size_t pixel_size, void* mem,
-                       hipaccMemoryType mem_type=Global);
+                       hipaccMemoryType mem_type=Global, bool own_mem=true);
         ~HipaccImageCPU();
 };
 
-extern long start_time;
-extern long end_time;
+// timing of the kernel launched last by the calling thread
+extern thread_local long start_time;
+extern thread_local long end_time;
 
 
 void hipaccStartTiming();
 void hipaccStopTiming();
+void hipaccStopTiming(const char *kernel, int width, int height, size_t pixel_bytes_read, size_t pixel_bytes_written);
 void hipaccCopyMemory(const HipaccImage &src, HipaccImage &dst);
 void hipaccCopyMemoryRegion(const HipaccAccessor &src, const HipaccAccessor &dst);
+void hipaccRunConcurrently(int threads, const std::vector<HipaccTask> &tasks);
+HipaccCPUConfig hipaccSelectCPUConfig(const HipaccCPUConfig &heuristic, const std::vector<HipaccCPUConfig> &configs);
+void hipaccLaunchKernelExploration(std::string kernel, std::string tuning_file, const HipaccCPUConfig &heuristic, bool tiled, const std::function<void(const HipaccCPUConfig &)> &fun);
 
 
 template<typename T>
@@ -64,11 +160,21 @@ HipaccImage hipaccCreateMemory(T *host_mem, size_t width, size_t height, size_t
 template<typename T>
 HipaccImage hipaccCreateMemory(T *host_mem, size_t width, size_t height);
 template<typename T>
+HipaccImage hipaccWrapMemory(T *mem, size_t width, size_t height, size_t stride);
+template<typename T>
+HipaccImage hipaccWrapMemory(T *mem, size_t width, size_t height);
+template<typename T>
 void hipaccWriteMemory(HipaccImage &img, T *host_mem);
 template<typename T>
 T *hipaccReadMemory(const HipaccImage &img);
 template<typename T>
 void hipaccWriteDomainFromMask(HipaccImage &dom, T* host_mem);
+template<typename T>
+T hipaccMedian(T *data, int size);
+template<typename Function>
+void hipaccParallelFor(int threads, int lower, int upper, int step, const Function &fun);
+template<typename Function>
+void hipaccParallelForStealing(int threads, int lower, int upper, int step, const Function &fun);
 
 
 #include "hipacc_cpu.tpp"
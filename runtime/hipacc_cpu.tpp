@@ -30,7 +30,11 @@
 template<typename T>
 HipaccImage createImage(T *host_mem, void *mem, size_t width, size_t height, size_t stride, size_t alignment, hipaccMemoryType mem_type) {
     HipaccImage img = std::make_shared<HipaccImageCPU>(width, height, stride, alignment, sizeof(T), mem, mem_type);
-    hipaccWriteMemory(img, host_mem ? host_mem : (T*)img->host);
+    if (host_mem) {
+        hipaccWriteMemory(img, host_mem);
+    } else {
+        std::memset(mem, 0, sizeof(T)*stride*height);
+    }
 
     return img;
 }
@@ -43,16 +47,30 @@ HipaccImage hipaccCreateMemory(T *host_mem, size_t width, size_t height, size_t
     alignment = (int)ceilf((float)alignment/sizeof(T)) * sizeof(T);
     int stride = (int)ceilf((float)(width)/(alignment/sizeof(T))) * (alignment/sizeof(T));
 
-    T *mem = new T[stride*height];
-    return createImage(host_mem, (void *)mem, width, height, stride, alignment);
+    void *mem = HipaccMemoryPool::getInstance().allocate(sizeof(T)*stride*height, alignment);
+    return createImage(host_mem, mem, width, height, stride, alignment);
 }
 
 
 // Allocate memory without any alignment considerations
 template<typename T>
 HipaccImage hipaccCreateMemory(T *host_mem, size_t width, size_t height) {
-    T *mem = new T[width*height];
-    return createImage(host_mem, (void *)mem, width, height, width, 0);
+    void *mem = HipaccMemoryPool::getInstance().allocate(sizeof(T)*width*height, sizeof(T));
+    return createImage(host_mem, mem, width, height, width, 0);
+}
+
+
+// Wrap caller-owned memory of stride*height pixels without copying it; the
+// memory has to outlive the image
+template<typename T>
+HipaccImage hipaccWrapMemory(T *mem, size_t width, size_t height, size_t stride) {
+    return std::make_shared<HipaccImageCPU>(width, height, stride, 0, sizeof(T), (void *)mem, Global, false);
+}
+
+
+template<typename T>
+HipaccImage hipaccWrapMemory(T *mem, size_t width, size_t height) {
+    return hipaccWrapMemory(mem, width, height, width);
 }
 
 
@@ -60,12 +78,13 @@ HipaccImage hipaccCreateMemory(T *host_mem, size_t width, size_t height) {
 template<typename T>
 void hipaccWriteMemory(HipaccImage &img, T *host_mem) {
     if (host_mem == nullptr) return;
+    if ((void *)host_mem == img->mem) return;
 
     size_t width  = img->width;
     size_t height = img->height;
     size_t stride = img->stride;
 
-    if ((char *)host_mem != img->host)
+    if ((char *)host_mem != img->host && img->host != (char *)img->mem)
         std::copy(host_mem, host_mem + width*height, (T*)img->host);
 
     if (stride > width) {
@@ -85,6 +104,9 @@ T *hipaccReadMemory(const HipaccImage &img) {
     size_t height = img->height;
     size_t stride = img->stride;
 
+    // without padding, the memory of the image is returned directly
+    if (img->host == (char *)img->mem) return (T*)img->mem;
+
     if (stride > width) {
         for (size_t i=0; i<height; ++i) {
             std::memcpy(&((T*)img->host)[i*width], &((T*)img->mem)[i*stride], sizeof(T)*width);
@@ -113,5 +135,105 @@ void hipaccWriteDomainFromMask(HipaccImage &dom, T* host_mem) {
 }
 
 
+// Select the median of large windows in linear time, reorders data
+template<typename T>
+T hipaccMedian(T *data, int size) {
+    std::nth_element(data, data + size/2, data + size);
+    return data[size/2];
+}
+
+
+// Distribute the iterations of for (i=lower; i<upper; i+=step) among threads
+// of the context; each thread calls fun(thread_lower, thread_upper) once for
+// one contiguous block of iterations
+template<typename Function>
+void hipaccParallelFor(int threads, int lower, int upper, int step, const Function &fun) {
+    if (upper <= lower) return;
+
+    HipaccContext &context = HipaccContext::getInstance();
+    long iterations = (upper - lower + step - 1) / step;
+    threads = (int)std::min<long>(context.getNumThreads(threads), iterations);
+
+    context.run(threads, [&] (int tid, int num_threads) {
+        long first = iterations * tid / num_threads;
+        long last = iterations * (tid + 1) / num_threads;
+        if (first < last) {
+            fun((int)(lower + first*step),
+                (int)std::min<long>(upper, lower + last*step));
+        }
+    });
+}
+
+
+// Distribute the iterations of for (i=lower; i<upper; i+=step) among threads
+// of the context for loops with irregular work per iteration: each thread
+// starts with one contiguous block of iterations and calls fun(i, i+step)
+// for one iteration at a time; threads running out of work steal the upper
+// half of the remaining iterations of another thread
+template<typename Function>
+void hipaccParallelForStealing(int threads, int lower, int upper, int step, const Function &fun) {
+    if (upper <= lower) return;
+
+    HipaccContext &context = HipaccContext::getInstance();
+    long iterations = (upper - lower + step - 1) / step;
+    threads = (int)std::min<long>(context.getNumThreads(threads), iterations);
+
+    std::unique_ptr<HipaccWorkRange[]> ranges(new HipaccWorkRange[threads]);
+    for (int tid=0; tid<threads; ++tid) {
+        ranges[tid].begin = iterations * tid / threads;
+        ranges[tid].end = iterations * (tid + 1) / threads;
+    }
+
+    context.run(threads, [&] (int tid, int num_threads) {
+        // nested calls run on fewer threads than there are ranges; fall back
+        // to static blocks of iterations for the granted threads
+        if (num_threads != threads) {
+            long first = iterations * tid / num_threads;
+            long last = iterations * (tid + 1) / num_threads;
+            for (long iteration=first; iteration<last; ++iteration) {
+                int idx = (int)(lower + iteration*step);
+                fun(idx, (int)std::min<long>(upper, (long)idx + step));
+            }
+            return;
+        }
+
+        HipaccWorkRange &own = ranges[tid];
+
+        while (true) {
+            long iteration = -1;
+            {
+                std::lock_guard<std::mutex> lock(own.mutex);
+                if (own.begin < own.end) iteration = own.begin++;
+            }
+
+            if (iteration >= 0) {
+                int idx = (int)(lower + iteration*step);
+                fun(idx, (int)std::min<long>(upper, (long)idx + step));
+                continue;
+            }
+
+            // stop once no thread has iterations left to steal; stolen
+            // iterations are always processed by the thief
+            long first = 0, last = 0;
+            for (int i=1; i<num_threads && first == last; ++i) {
+                HipaccWorkRange &victim = ranges[(tid + i) % num_threads];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                long remaining = victim.end - victim.begin;
+                if (remaining > 0) {
+                    first = victim.end - (remaining + 1) / 2;
+                    last = victim.end;
+                    victim.end = first;
+                }
+            }
+            if (first == last) return;
+
+            std::lock_guard<std::mutex> lock(own.mutex);
+            own.begin = first;
+            own.end = last;
+        }
+    });
+}
+
+
 #endif  // __HIPACC_CPU_TPP__
 
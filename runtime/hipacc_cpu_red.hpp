@@ -1,63 +1,46 @@
-#ifdef USE_OPENMP
-#  include <omp.h>
-#  define GET_NUM_CORES omp_get_num_procs()
-#  define GET_THREAD_ID omp_get_thread_num()
-#  define OPENMP_PRAGMA _Pragma("omp parallel for")
-#else
-#  define GET_NUM_CORES 1
-#  define GET_THREAD_ID 0
-#  define OPENMP_PRAGMA
+// number of threads used for reductions and binning, 0 means all cores
+#ifndef CPU_THREADS
+#  define CPU_THREADS 1
 #endif
 
 
 #define REDUCTION_CPU_2D(NAME, DATA_TYPE, REDUCE, WIDTH, HEIGHT, PPT) \
 inline DATA_TYPE NAME ##Kernel(DATA_TYPE input[HEIGHT][WIDTH], int width, int height, int stride, int offset_x=0, int offset_y=0) { \
-    int num_cores = GET_NUM_CORES; \
+    int num_threads = HipaccContext::getInstance().getNumThreads(CPU_THREADS); \
  \
-    DATA_TYPE* part_result = new DATA_TYPE[num_cores]; \
-    int* init = new int[num_cores]; \
- \
-    for (int tid = 0; tid < num_cores; ++tid) { \
-        init[tid] = 1; \
-    } \
+    DATA_TYPE* part_result = new DATA_TYPE[num_threads]; \
+    int* valid = new int[num_threads](); \
  \
+    /* each thread reduces one contiguous block of PPT rows */ \
     int end = height/PPT; \
  \
-    OPENMP_PRAGMA \
-    for (int gid_y = 0; gid_y < end; ++gid_y) { \
-        const int tid = GET_THREAD_ID; \
-        int y = offset_y + gid_y * PPT; \
-        if (init[tid] == 1) part_result[tid] = input[y][offset_x]; \
+    HipaccContext::getInstance().run(num_threads, [&] (int tid, int nt) { \
+        int lower = offset_y + (int)((long)end * tid / nt) * PPT; \
+        int upper = tid == nt-1 ? offset_y + height : \
+                    offset_y + (int)((long)end * (tid + 1) / nt) * PPT; \
+        if (lower >= upper || width <= 0) return; \
  \
-        for (int p = 0; p < PPT; ++p) { \
-            int gy = y + p; \
-            for (int gid_x = offset_x + init[tid]; gid_x < offset_x + width; ++gid_x) { \
-                part_result[tid] = REDUCE(part_result[tid], input[gy][gid_x]); \
-            } \
-            init[tid] = 0; \
+        DATA_TYPE result = input[lower][offset_x]; \
+        for (int gid_x = offset_x + 1; gid_x < offset_x + width; ++gid_x) { \
+            result = REDUCE(result, input[lower][gid_x]); \
         } \
-    } \
- \
-    if (int missing = height%PPT) { \
-       int gid_y = offset_y + end * PPT; \
- \
-       OPENMP_PRAGMA \
-       for (int m = 0; m < missing; ++m) { \
-            const int tid = GET_THREAD_ID; \
-            int gy = gid_y + m; \
+        for (int gy = lower + 1; gy < upper; ++gy) { \
             for (int gid_x = offset_x; gid_x < offset_x + width; ++gid_x) { \
-                part_result[tid] = REDUCE(part_result[tid], input[gy][gid_x]); \
+                result = REDUCE(result, input[gy][gid_x]); \
             } \
-       } \
-    } \
- \
-    for (int i = 1; i < num_cores; ++i) { \
-        part_result[0] = REDUCE(part_result[0], part_result[i]); \
+        } \
+        part_result[tid] = result; \
+        valid[tid] = 1; \
+    }); \
+ \
+    int first = 0; \
+    while (first < num_threads - 1 && !valid[first]) ++first; \
+    DATA_TYPE result = part_result[first]; \
+    for (int i = first + 1; i < num_threads; ++i) { \
+        if (valid[i]) result = REDUCE(result, part_result[i]); \
     } \
  \
-    DATA_TYPE result = part_result[0]; \
- \
-    delete [] init; \
+    delete [] valid; \
     delete [] part_result; \
  \
     return result; \
@@ -72,44 +55,33 @@ inline void BINNING ##Put(BIN_TYPE *_lmem, uint _offset, uint idx, BIN_TYPE val)
 } \
  \
 inline BIN_TYPE* NAME ##Kernel(DATA_TYPE input[HEIGHT][WIDTH], uint num_bins, int width, int height, int stride, int offset_x=0, int offset_y=0) { \
-    int num_cores = GET_NUM_CORES; \
+    int num_threads = HipaccContext::getInstance().getNumThreads(CPU_THREADS); \
  \
     BIN_TYPE *bins = new BIN_TYPE[num_bins](); \
-    BIN_TYPE *lbins = new BIN_TYPE[num_cores * num_bins](); \
+    BIN_TYPE *lbins = new BIN_TYPE[num_threads * num_bins](); \
+ \
+    /* each thread bins one contiguous block of PPT rows into its own bins */ \
     int end = height/PPT; \
  \
-    OPENMP_PRAGMA \
-    for (int gid_y = 0; gid_y < end; ++gid_y) { \
-        const int tid = GET_THREAD_ID; \
-        int y = offset_y + gid_y * PPT; \
+    HipaccContext::getInstance().run(num_threads, [&] (int tid, int nt) { \
+        int lower = offset_y + (int)((long)end * tid / nt) * PPT; \
+        int upper = tid == nt-1 ? offset_y + height : \
+                    offset_y + (int)((long)end * (tid + 1) / nt) * PPT; \
  \
-        for (int p = 0; p < PPT; ++p) { \
-            int gy = y + p; \
+        for (int gy = lower; gy < upper; ++gy) { \
             for (int gid_x = offset_x; gid_x < offset_x + width; ++gid_x) { \
                 BINNING(&lbins[tid * num_bins], num_bins, num_bins, gid_x, gy, input[gy][gid_x]); \
             } \
         } \
-    } \
+    }); \
  \
-    if (int missing = height%PPT) { \
-       int gid_y = offset_y + end * PPT; \
- \
-       OPENMP_PRAGMA \
-       for (int m = 0; m < missing; ++m) { \
-            const int tid = GET_THREAD_ID; \
-            int gy = gid_y + m; \
-            for (int gid_x = offset_x; gid_x < offset_x + width; ++gid_x) { \
-                BINNING(&lbins[tid * num_bins], num_bins, num_bins, gid_x, gy, input[gy][gid_x]); \
+    hipaccParallelFor(num_threads, 0, (int)num_bins, 1, [&] (int lower, int upper) { \
+        for (int i = lower; i < upper; ++i) { \
+            for (int tid = 0; tid < num_threads; ++tid) { \
+                bins[i] = REDUCE(bins[i], lbins[tid * num_bins + i]); \
             } \
-       } \
-    } \
- \
-    OPENMP_PRAGMA \
-    for (uint i = 0; i < num_bins; ++i) { \
-        for (int tid = 0; tid < num_cores; ++tid) { \
-            bins[i] = REDUCE(bins[i], lbins[tid * num_bins + i]); \
         } \
-    } \
+    }); \
  \
     delete [] lbins; \
  \
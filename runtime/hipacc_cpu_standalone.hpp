@@ -36,6 +36,37 @@
 
 #include "hipacc_base_standalone.hpp"
 
+#include <cfloat>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <new>
+#include <sstream>
+#ifdef _MSC_VER
+# include <malloc.h>
+#endif
+#ifdef __linux__
+# include <pthread.h>
+# include <sched.h>
+# include <sys/mman.h>
+#endif
+
+#define HIPACC_PAGE_SIZE      (4096)
+#define HIPACC_HUGE_PAGE_SIZE (2*1024*1024)
+// bytes of free blocks kept by the memory pool for reuse
+#ifndef HIPACC_POOL_LIMIT
+# define HIPACC_POOL_LIMIT    (size_t(256)*1024*1024)
+#endif
+// number of polls before an idle worker thread blocks
+#define HIPACC_SPIN_COUNT     (1 << 14)
+// bands of rows per thread and kernel run concurrently
+#define HIPACC_TASK_BANDS     (4)
+// runs of each configuration before it is timed by the exploration
+#define HIPACC_NUM_WARMUPS    (2)
+
+
+// set for threads executing a parallel region
+static thread_local bool hipacc_in_parallel = false;
 
 HipaccContext& HipaccContext::getInstance() {
     static HipaccContext instance;
@@ -43,19 +74,207 @@ HipaccContext& HipaccContext::getInstance() {
     return instance;
 }
 
+HipaccContext::HipaccContext()
+    : task(nullptr), task_threads(0), generation(0), pending(0),
+      shutdown(false) {
+}
+
+HipaccContext::~HipaccContext() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        shutdown = true;
+        generation++;
+    }
+    wakeup.notify_all();
+
+    for (auto &worker : workers)
+        worker.join();
+}
+
+int HipaccContext::getNumThreads(int threads) {
+    if (threads > 0) return threads;
+
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void HipaccContext::addWorkers(int num_threads) {
+    unsigned num_cores = std::thread::hardware_concurrency();
+
+    while ((int)workers.size() < num_threads - 1) {
+        int tid = (int)workers.size() + 1;
+        workers.emplace_back(&HipaccContext::work, this, tid);
+
+#ifdef __linux__
+        // the calling thread is not pinned, it belongs to the application
+        if (num_cores > 1) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(tid % num_cores, &cpus);
+            pthread_setaffinity_np(workers.back().native_handle(),
+                                   sizeof(cpu_set_t), &cpus);
+        }
+#else
+        (void)num_cores;
+#endif
+    }
+}
+
+void HipaccContext::work(int tid) {
+    unsigned seen = 0;
+    hipacc_in_parallel = true;
+
+    while (true) {
+        // poll for a while, kernels are often launched back-to-back
+        for (int i=0; generation.load(std::memory_order_acquire) == seen &&
+                      i<HIPACC_SPIN_COUNT; ++i)
+            std::this_thread::yield();
+
+        // the task is published together with its generation, take both
+        // under the lock so that they belong to the same run
+        const std::function<void(int, int)> *fun;
+        int threads;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeup.wait(lock, [&] { return generation.load() != seen; });
+            if (shutdown) return;
+            seen = generation.load();
+            fun = task;
+            threads = task_threads;
+        }
+
+        if (tid < threads) {
+            (*fun)(tid, threads);
+            pending.fetch_sub(1, std::memory_order_release);
+        }
+    }
+}
+
+void HipaccContext::run(int threads, const std::function<void(int, int)> &fun) {
+    threads = getNumThreads(threads);
+
+    if (threads == 1 || hipacc_in_parallel) {
+        fun(0, 1);
+        return;
+    }
+
+    std::lock_guard<std::mutex> dispatch(dispatch_mutex);
+    addWorkers(threads);
+
+    // workers are released by the new generation and signal completion by
+    // decrementing pending; there is no barrier among the threads
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &fun;
+        task_threads = threads;
+        pending.store(threads - 1, std::memory_order_relaxed);
+        generation.fetch_add(1, std::memory_order_release);
+    }
+    wakeup.notify_all();
+
+    hipacc_in_parallel = true;
+    fun(0, threads);
+    hipacc_in_parallel = false;
+
+    while (pending.load(std::memory_order_acquire) > 0)
+        std::this_thread::yield();
+}
+
+HipaccMemoryPool &HipaccMemoryPool::getInstance() {
+    // intentionally leaked, see class comment
+    static HipaccMemoryPool *instance = new HipaccMemoryPool();
+
+    return *instance;
+}
+
+void HipaccMemoryPool::freeBlock(void *mem) {
+#ifdef _MSC_VER
+    _aligned_free(mem);
+#else
+    free(mem);
+#endif
+}
+
+size_t HipaccMemoryPool::getSizeClass(size_t size) {
+    size_t granularity = size >= HIPACC_HUGE_PAGE_SIZE ?
+                         HIPACC_HUGE_PAGE_SIZE : HIPACC_PAGE_SIZE;
+    return (size + granularity - 1) / granularity * granularity;
+}
+
+void *HipaccMemoryPool::allocate(size_t size, size_t alignment) {
+    assert(alignment <= HIPACC_PAGE_SIZE && "Alignment exceeds page size");
+    size = getSizeClass(size);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto &blocks = free_blocks[size];
+        if (!blocks.empty()) {
+            void *mem = blocks.back();
+            blocks.pop_back();
+            free_bytes -= size;
+            return mem;
+        }
+    }
+
+    size_t page_size = size >= HIPACC_HUGE_PAGE_SIZE ?
+                       HIPACC_HUGE_PAGE_SIZE : HIPACC_PAGE_SIZE;
+    void *mem = nullptr;
+#ifdef _MSC_VER
+    mem = _aligned_malloc(size, page_size);
+#else
+    if (posix_memalign(&mem, page_size, size) != 0)
+        mem = nullptr;
+#endif
+    if (mem == nullptr)
+        throw std::bad_alloc();
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (page_size == HIPACC_HUGE_PAGE_SIZE)
+        madvise(mem, size, MADV_HUGEPAGE);
+#endif
+
+    return mem;
+}
+
+void HipaccMemoryPool::release(void *mem, size_t size) {
+    size = getSizeClass(size);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (free_bytes + size <= HIPACC_POOL_LIMIT) {
+            free_blocks[size].push_back(mem);
+            free_bytes += size;
+            return;
+        }
+    }
+
+    freeBlock(mem);
+}
+
+void HipaccMemoryPool::trim() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto &blocks : free_blocks) {
+        for (auto mem : blocks.second)
+            freeBlock(mem);
+    }
+    free_blocks.clear();
+    free_bytes = 0;
+}
+
 HipaccImageCPU::HipaccImageCPU(size_t width, size_t height, size_t stride,
                size_t alignment, size_t pixel_size, void* mem,
-               hipaccMemoryType mem_type)
+               hipaccMemoryType mem_type, bool own_mem)
     : HipaccImageBase(width, height, stride, alignment, pixel_size, mem,
-        mem_type), mem((char*)mem) {
+        mem_type, stride == width ? (char*)mem : nullptr),
+      mem((char*)mem), own_mem(own_mem) {
 }
 
 HipaccImageCPU::~HipaccImageCPU() {
-    delete[] mem;
+    if (own_mem)
+        HipaccMemoryPool::getInstance().release(mem, stride*height*pixel_size);
 }
 
-long start_time = 0L;
-long end_time = 0L;
+thread_local long start_time = 0L;
+thread_local long end_time = 0L;
 
 void hipaccStartTiming() {
     start_time = hipacc_time_micro();
@@ -69,6 +288,16 @@ void hipaccStopTiming() {
               << last_gpu_timing << "(ms)" << std::endl;
 }
 
+// stop timing and record the launch of a kernel reading and writing the given
+// number of bytes per pixel of its iteration space
+void hipaccStopTiming(const char *kernel, int width, int height,
+                      size_t pixel_bytes_read, size_t pixel_bytes_written) {
+    hipaccStopTiming();
+    size_t pixels = (size_t)width * height;
+    hipaccProfileKernel(kernel, start_time, end_time, width, height,
+                        pixels * pixel_bytes_read, pixels * pixel_bytes_written);
+}
+
 
 // Copy from memory to memory
 void hipaccCopyMemory(const HipaccImage &src, HipaccImage &dst) {
@@ -88,5 +317,185 @@ void hipaccCopyMemoryRegion(const HipaccAccessor &src, const HipaccAccessor &dst
 }
 
 
+
+// Run independent kernels concurrently: the rows of all kernels are split into
+// bands, which the threads of the context take one after another
+void hipaccRunConcurrently(int threads, const std::vector<HipaccTask> &tasks) {
+    struct Band {
+        const HipaccTask *task;
+        int lower, upper;
+    };
+
+    HipaccContext &context = HipaccContext::getInstance();
+    threads = context.getNumThreads(threads);
+
+    std::vector<Band> bands;
+    for (auto &task : tasks) {
+        int num_bands = HIPACC_TASK_BANDS * threads;
+        int rows = std::max(1, (task.height + num_bands - 1) / num_bands);
+        for (int lower=0; lower<task.height; lower+=rows) {
+            bands.push_back({ &task, lower, std::min(task.height, lower + rows) });
+        }
+    }
+    if (bands.empty()) return;
+
+    std::atomic<size_t> next(0);
+    context.run((int)std::min<size_t>(threads, bands.size()),
+                [&] (int, int) {
+        for (size_t i = next++; i < bands.size(); i = next++) {
+            bands[i].task->fun(bands[i].lower, bands[i].upper);
+        }
+    });
+}
+
+
+// Select the configuration tuned for the image size closest to the size of
+// the heuristic configuration; the heuristic configuration is used if no
+// configuration was tuned
+HipaccCPUConfig hipaccSelectCPUConfig(const HipaccCPUConfig &heuristic,
+        const std::vector<HipaccCPUConfig> &configs) {
+    HipaccCPUConfig config = heuristic;
+    float min_dist = FLT_MAX;
+
+    for (auto &tuned : configs) {
+        float dist = std::fabs(std::log((float)tuned.width / heuristic.width)) +
+                     std::fabs(std::log((float)tuned.height / heuristic.height));
+        if (dist < min_dist) {
+            min_dist = dist;
+            config = tuned;
+        }
+    }
+
+    return config;
+}
+
+
+// Store the configuration of a kernel in the tuning file, replacing the
+// configuration of the kernel for the same image size
+void hipaccWriteTuningFile(std::string tuning_file, std::string kernel,
+        const HipaccCPUConfig &config, float time) {
+    std::vector<std::string> lines;
+    std::ifstream in(tuning_file);
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream iss(line);
+        std::string name;
+        int width = 0, height = 0;
+        iss >> name >> width >> height;
+        if (line.empty() || line[0] == '#' || name != kernel ||
+            width != config.width || height != config.height)
+            lines.push_back(line);
+    }
+    in.close();
+
+    if (lines.empty())
+        lines.push_back("# kernel width height threads tile_x tile_y time(ms)");
+    std::ostringstream oss;
+    oss << kernel << " " << config.width << " " << config.height << " "
+        << config.threads << " " << config.tile_x << " " << config.tile_y
+        << " " << time;
+    lines.push_back(oss.str());
+
+    std::ofstream out(tuning_file);
+    if (!out.is_open()) {
+        std::cerr << "ERROR: Could not write tuning file '" << tuning_file
+                  << "'" << std::endl;
+        return;
+    }
+    for (auto &l : lines)
+        out << l << std::endl;
+}
+
+
+// Perform configuration exploration for a kernel call: the kernel is run
+// for each number of threads up to the number of cores and, for local
+// operators, for each tile size; each configuration is timed after warm-up
+// runs and the configuration with the lowest median is stored in the tuning
+// file
+void hipaccLaunchKernelExploration(std::string kernel, std::string tuning_file,
+        const HipaccCPUConfig &heuristic, bool tiled,
+        const std::function<void(const HipaccCPUConfig &)> &fun) {
+    int width = heuristic.width, height = heuristic.height;
+    int max_threads = HipaccContext::getInstance().getNumThreads();
+    HipaccCPUConfig opt_config = heuristic;
+    float opt_time = FLT_MAX;
+
+    std::cerr << "<HIPACC:> Exploring configurations for kernel '" << kernel
+              << "' (" << width << "x" << height << "): configuration provided"
+              << " by heuristic " << heuristic.threads << " threads";
+    if (tiled)
+        std::cerr << ", tile " << heuristic.tile_x << "x" << heuristic.tile_y;
+    std::cerr << ". " << std::endl;
+
+    // number of threads: powers of two and all cores
+    std::vector<int> threads;
+    for (int t=1; t<max_threads; t*=2)
+        threads.push_back(t);
+    threads.push_back(max_threads);
+
+    // tile sizes: multiples of the cache line up to the full width, tiles
+    // of the full width and height process the image without cache blocking
+    std::vector<int> tiles_x, tiles_y;
+    if (tiled) {
+        for (int x=64; x<width; x*=2) tiles_x.push_back(x);
+        tiles_x.push_back(width);
+        for (int y=4; y<height && y<=64; y*=2) tiles_y.push_back(y);
+        tiles_y.push_back(height);
+    } else {
+        tiles_x.push_back(0);
+        tiles_y.push_back(0);
+    }
+
+    for (auto num_threads : threads) {
+        for (auto tile_x : tiles_x) {
+            for (auto tile_y : tiles_y) {
+                HipaccCPUConfig config(width, height, num_threads, tile_x,
+                                       tile_y);
+                std::vector<float> times;
+
+                for (size_t i=0; i<HIPACC_NUM_WARMUPS; ++i)
+                    fun(config);
+                for (size_t i=0; i<HIPACC_NUM_ITERATIONS; ++i) {
+                    long start = hipacc_time_micro();
+                    fun(config);
+                    times.push_back((hipacc_time_micro() - start) * 1.0e-3f);
+                }
+
+                std::sort(times.begin(), times.end());
+                last_gpu_timing = times[times.size()/2];
+
+                if (last_gpu_timing < opt_time) {
+                    opt_time = last_gpu_timing;
+                    opt_config = config;
+                }
+
+                // print timing
+                std::cerr << "<HIPACC:> Kernel config: "
+                          << std::setw(3) << std::right << num_threads
+                          << " threads";
+                if (tiled)
+                    std::cerr << ", tile " << std::setw(5) << tile_x << "x"
+                              << std::setw(5) << std::left << tile_y
+                              << std::right;
+                std::cerr << ": " << std::setw(8) << std::fixed
+                          << std::setprecision(4) << last_gpu_timing << " | "
+                          << times.front() << " | " << times.back()
+                          << " (median(" << HIPACC_NUM_ITERATIONS
+                          << ") | minimum | maximum) ms" << std::endl;
+            }
+        }
+    }
+
+    last_gpu_timing = opt_time;
+    std::cerr << "<HIPACC:> Best configurations for kernel '" << kernel
+              << "': " << opt_config.threads << " threads";
+    if (tiled)
+        std::cerr << ", tile " << opt_config.tile_x << "x" << opt_config.tile_y;
+    std::cerr << ": " << opt_time << " ms" << std::endl;
+
+    hipaccWriteTuningFile(tuning_file, kernel, opt_config, opt_time);
+}
+
+
 #endif  // __HIPACC_CPU_STANDALONE_HPP__
 
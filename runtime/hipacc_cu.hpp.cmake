@@ -180,6 +180,7 @@ dim3 hipaccCalcGridFromBlock(hipacc_launch_info &info, dim3 &block);
 void hipaccInitCUDA();
 void hipaccCopyMemory(const HipaccImage &src, HipaccImage &dst);
 void hipaccCopyMemoryRegion(const HipaccAccessor &src, const HipaccAccessor &dst);
+void hipaccProfileLaunch(std::string kernel_name, dim3 grid, dim3 block);
 void hipaccLaunchKernel(const void *kernel, std::string kernel_name, dim3 grid, dim3 block, void **args, bool print_timing=true);
 void hipaccLaunchKernelBenchmark(const void *kernel, std::string kernel_name, dim3 grid, dim3 block, std::vector<void *> args, bool print_timing=true);
 void hipaccLaunchKernelExploration(std::string filename, std::string kernel, std::vector<void *> args,
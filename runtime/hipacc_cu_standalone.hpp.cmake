@@ -206,6 +206,15 @@ void hipaccUnbindTexture(const textureReference *tex) {
 }
 
 
+// Record the last launch in the profiler, ending now on the host clock
+void hipaccProfileLaunch(std::string kernel_name, dim3 grid, dim3 block) {
+    int64_t end = hipacc_time_micro();
+    int64_t start = end - (int64_t)(last_gpu_timing*1.0e3f);
+    hipaccProfileKernel(hipaccProfileName(kernel_name), start, end,
+                        grid.x*block.x, grid.y*block.y, 0, 0);
+}
+
+
 // Launch kernel
 void hipaccLaunchKernel(const void *kernel, std::string kernel_name, dim3 grid, dim3 block, void **args, bool print_timing) {
     cudaEvent_t start, end;
@@ -227,6 +236,7 @@ void hipaccLaunchKernel(const void *kernel, std::string kernel_name, dim3 grid,
 
     cudaEventDestroy(start);
     cudaEventDestroy(end);
+    hipaccProfileLaunch(kernel_name, grid, block);
 
     if (print_timing) {
         std::cerr << "<HIPACC:> Kernel timing ("<< block.x*block.y << ": " << block.x << "x" << block.y << "): " << last_gpu_timing << "(ms)" << std::endl;
@@ -417,6 +427,7 @@ void hipaccLaunchKernel(CUfunction &kernel, std::string kernel_name, dim3 grid,
 
     cudaEventDestroy(start);
     cudaEventDestroy(end);
+    hipaccProfileLaunch(kernel_name, grid, block);
 
     if (print_timing)
         std::cerr << "<HIPACC:> Kernel timing (" << block.x*block.y << ": " << block.x << "x" << block.y << "): " << last_gpu_timing << "(ms)" << std::endl;
@@ -0,0 +1,176 @@
+//
+// Copyright (c) 2014, Saarland University
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+// This is the frame pipeline of the Hipacc runtime for processing streams of
+// frames. It only depends on the C++ standard library and can be used from
+// Hipacc DSL code as well as from host code calling generated entry functions
+// such as hipaccRun() of Vivado.
+//
+// Each stage of the pipeline runs on its own thread, so that stage k of frame
+// t+1 overlaps with stage k+1 of frame t. Up to 'depth' frames are in flight
+// (2: double, 3: triple buffering), each of them in its own slot. The pipeline
+// owns one instance of Buffers per slot, constructed from the trailing
+// constructor arguments, which holds the intermediate images of a frame.
+// Stages are called as stage(frame, buffers) and a slot is reused once its
+// frame was popped.
+//
+//   HipaccPipeline<uchar *, Intermediates> pipeline({ stage0, stage1 }, 3,
+//                                                   width, height);
+//   pipeline.push(frame);
+//   uchar *result;
+//   if (pipeline.pop(result)) ...
+//
+// Vivado host code declares HipaccRunStreams next to hipaccRun(), which can
+// be used as Buffers to stream several frames through
+// hipaccRun(streams, ..., width, height).
+
+
+#ifndef __HIPACC_PIPELINE_HPP__
+#define __HIPACC_PIPELINE_HPP__
+
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+template<typename Frame, typename Buffers=int>
+class HipaccPipeline {
+    public:
+        typedef std::function<void(Frame &, Buffers &)> Stage;
+
+    private:
+        struct Entry {
+            Frame frame;
+            int slot;
+        };
+
+        // queues[k] holds the frames waiting for stage k, the last queue
+        // holds the frames done
+        std::vector<Stage> stages;
+        std::vector<std::deque<Entry>> queues;
+        std::vector<std::unique_ptr<Buffers>> buffers;
+        std::vector<std::thread> threads;
+        std::mutex mutex;
+        std::condition_variable changed;
+        int depth, in_flight;
+        size_t num_pushed, num_popped;
+        bool shutdown;
+        std::chrono::steady_clock::time_point first_push, last_pop;
+
+        HipaccPipeline(HipaccPipeline const &);
+        void operator=(HipaccPipeline const &);
+
+        void run(size_t k) {
+            while (true) {
+                Entry entry;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&] {
+                        return shutdown || !queues[k].empty();
+                    });
+                    if (queues[k].empty()) return;
+                    entry = queues[k].front();
+                    queues[k].pop_front();
+                }
+
+                stages[k](entry.frame, *buffers[entry.slot]);
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    queues[k+1].push_back(entry);
+                }
+                changed.notify_all();
+            }
+        }
+
+    public:
+        template<typename... Args>
+        HipaccPipeline(std::vector<Stage> stages, int depth=2, Args... args)
+            : stages(stages), queues(stages.size() + 1), depth(depth),
+              in_flight(0), num_pushed(0), num_popped(0), shutdown(false) {
+            assert(depth > 0 && "Pipeline requires at least one slot");
+            for (int i=0; i<depth; ++i)
+                buffers.emplace_back(new Buffers(args...));
+            for (size_t k=0; k<stages.size(); ++k) {
+                threads.emplace_back(&HipaccPipeline::run, this, k);
+            }
+        }
+
+        ~HipaccPipeline() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                shutdown = true;
+            }
+            changed.notify_all();
+            for (auto &thread : threads)
+                thread.join();
+        }
+
+        // add a frame, blocks while 'depth' frames are in flight
+        void push(Frame frame) {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&] { return in_flight < depth; });
+            if (num_pushed == 0)
+                first_push = std::chrono::steady_clock::now();
+            queues[0].push_back({ frame, (int)(num_pushed++ % depth) });
+            ++in_flight;
+            lock.unlock();
+            changed.notify_all();
+        }
+
+        // remove the oldest frame, blocks until it passed all stages; returns
+        // false if no frame is in flight
+        bool pop(Frame &frame) {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (in_flight == 0) return false;
+            changed.wait(lock, [&] { return !queues.back().empty(); });
+            frame = queues.back().front().frame;
+            queues.back().pop_front();
+            --in_flight;
+            ++num_popped;
+            last_pop = std::chrono::steady_clock::now();
+            lock.unlock();
+            changed.notify_all();
+
+            return true;
+        }
+
+        // frames per second sustained from the first push to the last pop
+        float getFPS() {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (num_popped == 0) return 0.0f;
+            std::chrono::duration<float> elapsed = last_pop - first_push;
+            return elapsed.count() > 0.0f ? num_popped / elapsed.count() : 0.0f;
+        }
+};
+
+
+#endif  // __HIPACC_PIPELINE_HPP__
@@ -30,8 +30,10 @@
 #include <hipacc_helper.hpp>
 
 
+#ifndef WIDTH
 #define WIDTH  4096
 #define HEIGHT 4096
+#endif
 
 
 using namespace hipacc;
@@ -32,8 +32,10 @@
 
 #define SIGMA_S 13
 #define SIGMA_R 16
+#ifndef WIDTH
 #define WIDTH   4032
 #define HEIGHT  3024
+#endif
 #define IMAGE   "../../common/img/fuerte_ship.jpg"
 
 
@@ -30,8 +30,10 @@
 #include <hipacc_helper.hpp>
 
 
+#ifndef WIDTH
 #define WIDTH  512
 #define HEIGHT 512
+#endif
 #define IMAGE1 "../../common/img/q5_00164.jpg"
 #define IMAGE2 "../../common/img/q5_00165.jpg"
 
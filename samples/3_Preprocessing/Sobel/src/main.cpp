@@ -32,8 +32,10 @@
 
 #define SIZE_X 7
 #define SIZE_Y 7
+#ifndef WIDTH
 #define WIDTH  4032
 #define HEIGHT 3024
+#endif
 #define IMAGE  "../../common/img/fuerte_ship.jpg"
 
 #if SIZE_X == 7
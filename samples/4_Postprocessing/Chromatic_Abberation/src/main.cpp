@@ -30,8 +30,10 @@
 #include <hipacc_helper.hpp>
 
 
+#ifndef WIDTH
 #define WIDTH  4032
 #define HEIGHT 3024
+#endif
 #define IMAGE  "../../common/img/fuerte_ship.jpg"
 
 #define BILIN
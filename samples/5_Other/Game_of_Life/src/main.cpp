@@ -30,8 +30,10 @@
 #include <hipacc_helper.hpp>
 
 
+#ifndef WIDTH
 #define WIDTH  800
 #define HEIGHT 600
+#endif
 
 
 using namespace hipacc;
@@ -30,8 +30,10 @@
 #include <hipacc_helper.hpp>
 
 
+#ifndef WIDTH
 #define WIDTH  1600
 #define HEIGHT 900
+#endif
 
 #define PACK_INT
 
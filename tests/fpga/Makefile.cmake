@@ -36,6 +36,8 @@ ALTERA_CXX     := arm-linux-gnueabihf-g++
 # use specific configuration for kernels -> set HIPACC_CONFIG to nxm
 # generate code that explores configuration -> set HIPACC_EXPLORE to off|on
 # generate code that times kernel execution -> set HIPACC_TIMING to off|on
+# process local operators in n column-parallel lanes -> set HIPACC_LANES to n
+# share line buffers among local operators -> set HIPACC_SHARE_WINDOWS to off|on
 HIPACC_LMEM?=off
 HIPACC_TEX?=off
 HIPACC_VEC?=off
@@ -74,6 +76,12 @@ endif
 ifdef HIPACC_TARGET_II
     HIPACC_OPTS+= -target-II $(HIPACC_TARGET_II)
 endif
+ifdef HIPACC_LANES
+    HIPACC_OPTS+= -fpga-lanes $(HIPACC_LANES)
+endif
+ifdef HIPACC_SHARE_WINDOWS
+    HIPACC_OPTS+= -share-windows $(HIPACC_SHARE_WINDOWS)
+endif
 
 # set target GPU architecture to the compute capability encoded in target
 GPU_ARCH := $(shell echo $(HIPACC_TARGET) |cut -f2 -d-)
@@ -0,0 +1,246 @@
+//
+// Copyright (c) 2012, University of Erlangen-Nuremberg
+// Copyright (c) 2012, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "hipacc.hpp"
+
+// Frames smaller than the maximum frame size, e.g.
+//   make vivado TEST_CASE=./tests/frame_size
+// The line buffers are sized by the largest image, MAX_FRAME, whereas the
+// pipeline processes frames of WIDTH x HEIGHT pixels. hipaccRun() gets the
+// size of the frame at runtime, so that all filter loops, stream copies, and
+// window generators stop at the frame size. The C simulation compares all
+// pixels to a reference on the host, a frame processed with the maximum size
+// would not match at the right and bottom border.
+
+// variables set by Makefile
+#ifndef SIZE_X
+#define SIZE_X 5
+#define SIZE_Y 5
+#endif
+#ifndef WIDTH
+#define WIDTH  200
+#define HEIGHT 60
+#endif
+#ifndef MAX_WIDTH
+#define MAX_WIDTH  640
+#define MAX_HEIGHT 120
+#endif
+
+using namespace hipacc;
+using namespace hipacc::math;
+
+
+// weighted sum with asymmetric coefficients, so that misplaced pixels show up
+class WeightedSum : public Kernel<ushort> {
+    private:
+        Accessor<uchar> &Input;
+        Mask<uchar> &cMask;
+
+    public:
+        WeightedSum(IterationSpace<ushort> &IS, Accessor<uchar>
+                &Input, Mask<uchar> &cMask) :
+            Kernel(IS),
+            Input(Input),
+            cMask(cMask)
+        { add_accessor(&Input); }
+
+        void kernel() {
+#pragma hipacc bw(sum,16)
+            ushort sum = 0;
+#pragma hipacc bw(convolve,16)
+            sum = convolve(cMask, Reduce::SUM, [&] () -> ushort {
+                    return cMask() * Input(cMask);
+                    });
+            output() = sum;
+        }
+};
+
+class Difference : public Kernel<ushort> {
+    private:
+        Accessor<ushort> &Input1;
+        Accessor<ushort> &Input2;
+
+    public:
+        Difference(IterationSpace<ushort> &IS, Accessor<ushort> &Input1,
+                Accessor<ushort> &Input2) :
+            Kernel(IS),
+            Input1(Input1),
+            Input2(Input2)
+        { add_accessor(&Input1); add_accessor(&Input2); }
+
+        void kernel() {
+            ushort in1 = Input1();
+            ushort in2 = Input2();
+            output() = in1 > in2 ? in1 - in2 : in2 - in1;
+        }
+};
+
+
+// reference with the border handling of the accessors
+enum RefBorder { REF_CLAMP, REF_CONSTANT };
+
+void weighted_sum(uchar *in, ushort *out, const uchar *mask, RefBorder mode,
+                  uchar value, int width, int height) {
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            ushort sum = 0;
+            for (int yf = 0; yf < SIZE_Y; ++yf) {
+                for (int xf = 0; xf < SIZE_X; ++xf) {
+                    int iy = y+yf-SIZE_Y/2;
+                    int ix = x+xf-SIZE_X/2;
+                    uchar pixel = value;
+                    if (mode == REF_CLAMP ||
+                        (iy >= 0 && iy < height && ix >= 0 && ix < width)) {
+                        iy = iy < 0 ? 0 : iy >= height ? height-1 : iy;
+                        ix = ix < 0 ? 0 : ix >= width ? width-1 : ix;
+                        pixel = in[iy*width + ix];
+                    }
+                    sum += mask[yf*SIZE_X + xf] * pixel;
+                }
+            }
+            out[y*width + x] = sum;
+        }
+    }
+}
+
+
+/*************************************************************************
+ * Main function                                                         *
+ *************************************************************************/
+int main(int argc, const char **argv) {
+    const int width = WIDTH;
+    const int height = HEIGHT;
+
+    // only filter kernel sizes 3x3, 5x5, and 7x7 implemented
+    if (SIZE_X != SIZE_Y || !(SIZE_X == 3 || SIZE_X == 5 || SIZE_X == 7)) {
+        fprintf(stderr, "Wrong filter kernel size. "
+                        "Currently supported values: 3x3, 5x5, and 7x7!\n");
+        exit(EXIT_FAILURE);
+    }
+    if (width >= MAX_WIDTH || height >= MAX_HEIGHT) {
+        fprintf(stderr, "Frame has to be smaller than the maximum frame!\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // convolution filter mask, coefficients 1 + (x + 2*y) % 4
+    const uchar mask[SIZE_Y][SIZE_X] = {
+#if SIZE_X == 3
+        { 1, 2, 3 },
+        { 3, 4, 1 },
+        { 1, 2, 3 }
+#elif SIZE_X == 5
+        { 1, 2, 3, 4, 1 },
+        { 3, 4, 1, 2, 3 },
+        { 1, 2, 3, 4, 1 },
+        { 3, 4, 1, 2, 3 },
+        { 1, 2, 3, 4, 1 }
+#elif SIZE_X == 7
+        { 1, 2, 3, 4, 1, 2, 3 },
+        { 3, 4, 1, 2, 3, 4, 1 },
+        { 1, 2, 3, 4, 1, 2, 3 },
+        { 3, 4, 1, 2, 3, 4, 1 },
+        { 1, 2, 3, 4, 1, 2, 3 },
+        { 3, 4, 1, 2, 3, 4, 1 },
+        { 1, 2, 3, 4, 1, 2, 3 }
+#endif
+    };
+
+    // host memory for image of width x height pixels
+    uchar *host_in = (uchar*)malloc(width*height);
+    ushort *ref_clamp = (ushort*)malloc(width*height*sizeof(ushort));
+    ushort *ref_const = (ushort*)malloc(width*height*sizeof(ushort));
+    for (int i = 0; i < width*height; ++i) {
+        host_in[i] = (uchar)(rand() % 256);
+    }
+
+    // largest frame, sizes the line buffers only
+    Image<uchar> MAX_FRAME(MAX_WIDTH, MAX_HEIGHT);
+
+    // input and output images of width x height pixels
+    Image<uchar> IN(width, height);
+    Image<ushort> SUM_CLAMP(width, height);
+    Image<ushort> SUM_CONST(width, height);
+    Image<ushort> OUT(width, height);
+
+    // filter mask
+    Mask<uchar> M(mask);
+
+    IN = host_in;
+
+    // the input is read by two local operators with different borders
+    BoundaryCondition<uchar> BcInClamp(IN, M, Boundary::CLAMP);
+    Accessor<uchar> AccInClamp(BcInClamp);
+    IterationSpace<ushort> IsSumClamp(SUM_CLAMP);
+    WeightedSum WClamp(IsSumClamp, AccInClamp, M);
+
+    BoundaryCondition<uchar> BcInConst(IN, M, Boundary::CONSTANT, 42);
+    Accessor<uchar> AccInConst(BcInConst);
+    IterationSpace<ushort> IsSumConst(SUM_CONST);
+    WeightedSum WConst(IsSumConst, AccInConst, M);
+
+    Accessor<ushort> AccSumClamp(SUM_CLAMP);
+    Accessor<ushort> AccSumConst(SUM_CONST);
+    IterationSpace<ushort> IsOut(OUT);
+    Difference D(IsOut, AccSumClamp, AccSumConst);
+
+    WClamp.execute();
+    WConst.execute();
+    D.execute();
+
+    ushort *output = OUT.data();
+
+    // compare results
+    weighted_sum(host_in, ref_clamp, (const uchar *)mask, REF_CLAMP, 42,
+                 width, height);
+    weighted_sum(host_in, ref_const, (const uchar *)mask, REF_CONSTANT, 42,
+                 width, height);
+    int errors = 0;
+    for (int i = 0; i < width*height; ++i) {
+        ushort ref = ref_clamp[i] > ref_const[i] ? ref_clamp[i] - ref_const[i]
+                                                 : ref_const[i] - ref_clamp[i];
+        if (output[i] != ref) {
+            if (errors++ < 10) {
+                fprintf(stderr, "Mismatch at (%d,%d): %d vs. %d\n",
+                        i%width, i/width, output[i], ref);
+            }
+        }
+    }
+
+    // memory cleanup
+    free(host_in);
+    free(ref_clamp);
+    free(ref_const);
+
+    if (errors) {
+        fprintf(stderr, "Test FAILED: %d mismatches\n", errors);
+        return EXIT_FAILURE;
+    }
+    fprintf(stdout, "Test PASSED\n");
+    return EXIT_SUCCESS;
+}
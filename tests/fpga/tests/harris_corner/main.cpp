@@ -26,6 +26,7 @@
 
 #include <iostream>
 #include <vector>
+#include <algorithm>
 #include <numeric>
 
 #include <float.h>
@@ -40,6 +41,9 @@
 
 //#define TEST
 
+// Both derivatives read the input with the same window and border handling,
+// so that they share one line buffer for Vivado. Run the test also with
+// HIPACC_SHARE_WINDOWS=off, both configurations have to match the reference.
 
 // variables set by Makefile
 #ifdef TEST
@@ -181,6 +185,59 @@ class HarrisCorner : public Kernel<uchar> {
 };
 
 
+// reference with clamp border handling, reduces like the kernels above
+template<typename in_t>
+void convolve_ref(in_t *in, float *out, const float *mask, int size_x,
+                  int size_y, int width, int height) {
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            bool first = true;
+            float result = 0.0f;
+            for (int yf = 0; yf < size_y; ++yf) {
+                for (int xf = 0; xf < size_x; ++xf) {
+                    // domains skip zero coefficients
+                    if (mask[yf*size_x + xf] == 0.0f) continue;
+                    int iy = std::min(std::max(y+yf-size_y/2, 0), height-1);
+                    int ix = std::min(std::max(x+xf-size_x/2, 0), width-1);
+                    float val = in[iy*width + ix] * mask[yf*size_x + xf];
+                    if (first) result = val;
+                    else result += val;
+                    first = false;
+                }
+            }
+            float sum = 0.0f;
+            sum += result;
+            out[y*width + x] = sum;
+        }
+    }
+}
+
+void harris_corner_ref(uchar *in, uchar *out, const float *gauss,
+                       const float *mask_x, const float *mask_y, float k,
+                       float threshold, int width, int height) {
+    std::vector<float> dx(width*height), dy(width*height);
+    std::vector<float> sx(width*height), sy(width*height), sxy(width*height);
+    std::vector<float> gx(width*height), gy(width*height), gxy(width*height);
+    convolve_ref(in, dx.data(), mask_x, 3, 3, width, height);
+    convolve_ref(in, dy.data(), mask_y, 3, 3, width, height);
+    for (int i = 0; i < width*height; ++i) {
+        sx[i] = dx[i] * dx[i];
+        sy[i] = dy[i] * dy[i];
+        sxy[i] = dx[i] * dy[i];
+    }
+    convolve_ref(sx.data(), gx.data(), gauss, SIZE_X, SIZE_Y, width, height);
+    convolve_ref(sy.data(), gy.data(), gauss, SIZE_X, SIZE_Y, width, height);
+    convolve_ref(sxy.data(), gxy.data(), gauss, SIZE_X, SIZE_Y, width, height);
+    for (int i = 0; i < width*height; ++i) {
+        float x = gx[i];
+        float y = gy[i];
+        float xy = gxy[i];
+        float R = ((x * y) - (xy * xy)) - (k * (x + y) * (x + y));
+        out[i] = R > threshold ? 1 : 0;
+    }
+}
+
+
 /*************************************************************************
  * Main function                                                         *
  *************************************************************************/
@@ -369,9 +426,30 @@ int main(int argc, const char **argv) {
     }
 #endif
 
+    // compare results
+    uchar *ref_out = (uchar *)malloc(sizeof(uchar)*width*height);
+    harris_corner_ref(host_in, ref_out, (const float *)filter_xy,
+                      (const float *)mask_x, (const float *)mask_y, k,
+                      threshold, width, height);
+    int errors = 0;
+    for (int i = 0; i < width*height; ++i) {
+        if (host_out[i] != ref_out[i]) {
+            if (errors++ < 10) {
+                fprintf(stderr, "Mismatch at (%d,%d): %d vs. %d\n",
+                        i%width, i/width, host_out[i], ref_out[i]);
+            }
+        }
+    }
+    free(ref_out);
+
     //free(host_in);
     //free(host_out);
 
+    if (errors) {
+        fprintf(stderr, "Test FAILED: %d mismatches\n", errors);
+        return EXIT_FAILURE;
+    }
+    fprintf(stdout, "Test PASSED\n");
     return EXIT_SUCCESS;
 }
 
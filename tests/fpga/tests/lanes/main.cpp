@@ -0,0 +1,204 @@
+//
+// Copyright (c) 2012, University of Erlangen-Nuremberg
+// Copyright (c) 2012, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <iostream>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "hipacc.hpp"
+
+// Local operator processed in column-parallel lanes, e.g.
+//   make vivado TEST_CASE=./tests/lanes HIPACC_LANES=4 HIPACC_PPT=4
+// The C simulation compares all pixels, including the image borders and the
+// aprons shared by neighbouring lanes, to a reference on the host.
+// WIDTH has to be a multiple of HIPACC_PPT.
+
+// variables set by Makefile
+#ifndef SIZE_X
+#define SIZE_X 5
+#define SIZE_Y 5
+#endif
+#ifndef WIDTH
+#define WIDTH  1020
+#define HEIGHT 64
+#endif
+
+using namespace hipacc;
+using namespace hipacc::math;
+
+
+// binomial filter in Hipacc
+class BinomialFilter : public Kernel<uchar> {
+    private:
+        Accessor<uchar> &Input;
+        Mask<uchar> &cMask;
+
+    public:
+        BinomialFilter(IterationSpace<uchar> &IS, Accessor<uchar>
+                &Input, Mask<uchar> &cMask) :
+            Kernel(IS),
+            Input(Input),
+            cMask(cMask)
+        { add_accessor(&Input); }
+
+        void kernel() {
+#pragma hipacc bw(sum,16)
+            ushort sum = 0;
+#pragma hipacc bw(convolve,16)
+            sum = convolve(cMask, Reduce::SUM, [&] () -> ushort {
+                    return cMask() * Input(cMask);
+                    });
+            output() = sum
+#if SIZE_X == 3
+              / 16;
+#else
+              / 256;
+#endif
+        }
+};
+
+
+// reference with the border handling of the accessors
+enum RefBorder { REF_CLAMP, REF_MIRROR, REF_CONSTANT };
+
+int get_coord(int c, int size, RefBorder mode) {
+    if (c >= 0 && c < size) return c;
+    switch (mode) {
+        case REF_CLAMP:  return c < 0 ? 0 : size-1;
+        case REF_MIRROR: return c < 0 ? -c-1 : 2*size-c-1;
+        default:         return -1;
+    }
+}
+
+void binomial_filter(uchar *in, uchar *out, const uchar *mask, RefBorder mode,
+                     uchar value, int width, int height) {
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            int sum = 0;
+            for (int yf = 0; yf < SIZE_Y; ++yf) {
+                for (int xf = 0; xf < SIZE_X; ++xf) {
+                    int iy = get_coord(y+yf-SIZE_Y/2, height, mode);
+                    int ix = get_coord(x+xf-SIZE_X/2, width, mode);
+                    uchar pixel = iy < 0 || ix < 0 ? value : in[iy*width + ix];
+                    sum += mask[yf*SIZE_X + xf] * pixel;
+                }
+            }
+            out[y*width + x] = (ushort)sum / (SIZE_X == 3 ? 16 : 256);
+        }
+    }
+}
+
+
+/*************************************************************************
+ * Main function                                                         *
+ *************************************************************************/
+int main(int argc, const char **argv) {
+    const int width = WIDTH;
+    const int height = HEIGHT;
+
+    // convolution filter mask
+    const uchar mask[SIZE_Y][SIZE_X] = {
+#if SIZE_X == 3
+        { 1,  2,  1 },
+        { 2,  4,  2 },
+        { 1,  2,  1 }
+#else
+        { 1,  4,  6,  4,  1 },
+        { 4, 16, 24, 16,  4 },
+        { 6, 24, 36, 24,  6 },
+        { 4, 16, 24, 16,  4 },
+        { 1,  4,  6,  4,  1 }
+#endif
+    };
+
+    // host memory for image of width x height pixels
+    uchar *host_in = (uchar*)malloc(width*height);
+    uchar *ref_out = (uchar*)malloc(width*height);
+    for (int i = 0; i < width*height; ++i) {
+        host_in[i] = (uchar)(rand() % 256);
+    }
+
+    // input and output images of width x height pixels
+    Image<uchar> IN(width, height);
+    Image<uchar> OUT_CLAMP(width, height);
+    Image<uchar> OUT_MIRROR(width, height);
+    Image<uchar> OUT_CONST(width, height);
+
+    // filter mask
+    Mask<uchar> M(mask);
+
+    IN = host_in;
+
+    BoundaryCondition<uchar> BcInClamp(IN, M, Boundary::CLAMP);
+    Accessor<uchar> AccInClamp(BcInClamp);
+    IterationSpace<uchar> IsOutClamp(OUT_CLAMP);
+    BinomialFilter BClamp(IsOutClamp, AccInClamp, M);
+
+    BoundaryCondition<uchar> BcInMirror(IN, M, Boundary::MIRROR);
+    Accessor<uchar> AccInMirror(BcInMirror);
+    IterationSpace<uchar> IsOutMirror(OUT_MIRROR);
+    BinomialFilter BMirror(IsOutMirror, AccInMirror, M);
+
+    BoundaryCondition<uchar> BcInConst(IN, M, Boundary::CONSTANT, 42);
+    Accessor<uchar> AccInConst(BcInConst);
+    IterationSpace<uchar> IsOutConst(OUT_CONST);
+    BinomialFilter BConst(IsOutConst, AccInConst, M);
+
+    BClamp.execute();
+    BMirror.execute();
+    BConst.execute();
+
+    // compare results, each lane has to match the reference up to the
+    // borders of its stripe
+    const RefBorder modes[] = { REF_CLAMP, REF_MIRROR, REF_CONSTANT };
+    uchar *outputs[] = { OUT_CLAMP.data(), OUT_MIRROR.data(),
+                         OUT_CONST.data() };
+    int errors = 0;
+    for (int m = 0; m < 3; ++m) {
+        binomial_filter(host_in, ref_out, (const uchar *)mask, modes[m], 42,
+                        width, height);
+        for (int i = 0; i < width*height; ++i) {
+            if (outputs[m][i] != ref_out[i]) {
+                if (errors++ < 10) {
+                    fprintf(stderr, "Mismatch for border %d at (%d,%d): %d vs. %d\n",
+                            m, i%width, i/width, outputs[m][i], ref_out[i]);
+                }
+            }
+        }
+    }
+
+    // memory cleanup
+    free(host_in);
+    free(ref_out);
+
+    if (errors) {
+        fprintf(stderr, "Test FAILED: %d mismatches\n", errors);
+        return EXIT_FAILURE;
+    }
+    fprintf(stdout, "Test PASSED\n");
+    return EXIT_SUCCESS;
+}
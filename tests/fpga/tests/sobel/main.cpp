@@ -25,6 +25,7 @@
 //
 
 #include <iostream>
+#include <algorithm>
 #include <vector>
 
 #include <float.h>
@@ -38,6 +39,10 @@
 
 //#define TEST
 
+// Both derivatives read the input with the same window and border handling,
+// so that they share one line buffer for Vivado. Run the test also with
+// HIPACC_SHARE_WINDOWS=off, both configurations have to match the reference.
+
 // variables set by Makefile
 #ifdef TEST
 #define WIDTH  24
@@ -101,6 +106,37 @@ class Combine : public Kernel<uchar> {
 };
 
 
+// reference with clamp border handling
+void sobel_ref(uchar *in, short *out, const char *mask, int width,
+               int height) {
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            short sum = 0;
+            for (int yf = 0; yf < 3; ++yf) {
+                for (int xf = 0; xf < 3; ++xf) {
+                    int iy = std::min(std::max(y+yf-1, 0), height-1);
+                    int ix = std::min(std::max(x+xf-1, 0), width-1);
+                    sum += mask[yf*3 + xf] * in[iy*width + ix];
+                }
+            }
+            out[y*width + x] = sum;
+        }
+    }
+}
+
+void magnitude_ref(uchar *in, float *out, const char *mask_x,
+                   const char *mask_y, int width, int height) {
+    std::vector<short> dx(width*height), dy(width*height);
+    sobel_ref(in, dx.data(), mask_x, width, height);
+    sobel_ref(in, dy.data(), mask_y, width, height);
+    for (int i = 0; i < width*height; ++i) {
+        float fx = dx[i];
+        float fy = dy[i];
+        out[i] = sqrtf(((fx * fx) + (fy * fy)));
+    }
+}
+
+
 /*************************************************************************
  * Main function                                                         *
  *************************************************************************/
@@ -203,10 +239,33 @@ int main(int argc, const char **argv) {
     }
 #endif
 
+    // compare results; magnitudes of 256 and more have no defined uchar
+    // value in Combine and are skipped
+    float *ref_out = (float*)malloc(width*height*sizeof(float));
+    magnitude_ref(host_in, ref_out, (const char *)mask_x,
+                  (const char *)mask_y, width, height);
+    int errors = 0;
+    for (int i = 0; i < width*height; ++i) {
+        if (ref_out[i] >= 256.0f)
+            continue;
+        if (host_out[i] != (uchar)ref_out[i]) {
+            if (errors++ < 10) {
+                fprintf(stderr, "Mismatch at (%d,%d): %d vs. %d\n",
+                        i%width, i/width, host_out[i], (uchar)ref_out[i]);
+            }
+        }
+    }
+
     // memory cleanup
     //free(host_in);
     //free(host_out);
+    free(ref_out);
 
+    if (errors) {
+        fprintf(stderr, "Test FAILED: %d mismatches\n", errors);
+        return EXIT_FAILURE;
+    }
+    fprintf(stdout, "Test PASSED\n");
     return EXIT_SUCCESS;
 }
 
@@ -0,0 +1,227 @@
+//
+// Copyright (c) 2012, University of Erlangen-Nuremberg
+// Copyright (c) 2012, Siemens AG
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "hipacc.hpp"
+
+// Local operator on vectorized streams, e.g.
+//   make vivado TEST_CASE=./tests/vect HIPACC_PPT=6 SIZE_X=13 SIZE_Y=3
+// Regression test for pixels per thread that are no power of two, like 5, 6,
+// and 12, and for horizontal aprons smaller and larger than the vector. The C
+// simulation compares all pixels to a reference on the host for each border
+// mode. WIDTH has to be a multiple of HIPACC_PPT, the default of 960 is a
+// multiple of 1-6, 8, 10, 12, and 16.
+
+// variables set by Makefile
+#ifndef SIZE_X
+#define SIZE_X 5
+#define SIZE_Y 5
+#endif
+#ifndef WIDTH
+#define WIDTH  960
+#define HEIGHT 32
+#endif
+
+using namespace hipacc;
+using namespace hipacc::math;
+
+
+// weighted sum with asymmetric coefficients, so that misplaced pixels show up
+class WeightedSum : public Kernel<ushort> {
+    private:
+        Accessor<uchar> &Input;
+        Mask<uchar> &cMask;
+
+    public:
+        WeightedSum(IterationSpace<ushort> &IS, Accessor<uchar>
+                &Input, Mask<uchar> &cMask) :
+            Kernel(IS),
+            Input(Input),
+            cMask(cMask)
+        { add_accessor(&Input); }
+
+        void kernel() {
+#pragma hipacc bw(sum,16)
+            ushort sum = 0;
+#pragma hipacc bw(convolve,16)
+            sum = convolve(cMask, Reduce::SUM, [&] () -> ushort {
+                    return cMask() * Input(cMask);
+                    });
+            output() = sum;
+        }
+};
+
+
+// reference with the border handling of the accessors
+enum RefBorder { REF_CLAMP, REF_MIRROR, REF_MIRROR_101, REF_CONSTANT };
+
+int get_coord(int c, int size, RefBorder mode) {
+    if (c >= 0 && c < size) return c;
+    switch (mode) {
+        case REF_CLAMP:      return c < 0 ? 0 : size-1;
+        case REF_MIRROR:     return c < 0 ? -c-1 : 2*size-c-1;
+        case REF_MIRROR_101: return c < 0 ? -c : 2*size-c-2;
+        default:             return -1;
+    }
+}
+
+void weighted_sum(uchar *in, ushort *out, const uchar *mask, RefBorder mode,
+                  uchar value, int width, int height) {
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            ushort sum = 0;
+            for (int yf = 0; yf < SIZE_Y; ++yf) {
+                for (int xf = 0; xf < SIZE_X; ++xf) {
+                    int iy = get_coord(y+yf-SIZE_Y/2, height, mode);
+                    int ix = get_coord(x+xf-SIZE_X/2, width, mode);
+                    uchar pixel = iy < 0 || ix < 0 ? value : in[iy*width + ix];
+                    sum += mask[yf*SIZE_X + xf] * pixel;
+                }
+            }
+            out[y*width + x] = sum;
+        }
+    }
+}
+
+
+/*************************************************************************
+ * Main function                                                         *
+ *************************************************************************/
+int main(int argc, const char **argv) {
+    const int width = WIDTH;
+    const int height = HEIGHT;
+
+    // only filter kernel sizes 3x3, 5x5, 7x7, and 13x3 implemented
+    if (!(SIZE_X == SIZE_Y && (SIZE_X == 3 || SIZE_X == 5 || SIZE_X == 7)) &&
+        !(SIZE_X == 13 && SIZE_Y == 3)) {
+        fprintf(stderr, "Wrong filter kernel size. "
+                        "Currently supported values: 3x3, 5x5, 7x7, and 13x3!\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // convolution filter mask, coefficients 1 + (x + 2*y) % 4
+    const uchar mask[SIZE_Y][SIZE_X] = {
+#if SIZE_X == 3
+        { 1, 2, 3 },
+        { 3, 4, 1 },
+        { 1, 2, 3 }
+#elif SIZE_X == 5
+        { 1, 2, 3, 4, 1 },
+        { 3, 4, 1, 2, 3 },
+        { 1, 2, 3, 4, 1 },
+        { 3, 4, 1, 2, 3 },
+        { 1, 2, 3, 4, 1 }
+#elif SIZE_X == 7
+        { 1, 2, 3, 4, 1, 2, 3 },
+        { 3, 4, 1, 2, 3, 4, 1 },
+        { 1, 2, 3, 4, 1, 2, 3 },
+        { 3, 4, 1, 2, 3, 4, 1 },
+        { 1, 2, 3, 4, 1, 2, 3 },
+        { 3, 4, 1, 2, 3, 4, 1 },
+        { 1, 2, 3, 4, 1, 2, 3 }
+#elif SIZE_X == 13
+        { 1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4, 1 },
+        { 3, 4, 1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3 },
+        { 1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4, 1 }
+#endif
+    };
+
+    // host memory for image of width x height pixels
+    uchar *host_in = (uchar*)malloc(width*height);
+    ushort *ref_out = (ushort*)malloc(width*height*sizeof(ushort));
+    for (int i = 0; i < width*height; ++i) {
+        host_in[i] = (uchar)(rand() % 256);
+    }
+
+    // input and output images of width x height pixels
+    Image<uchar> IN(width, height);
+    Image<ushort> OUT_CLAMP(width, height);
+    Image<ushort> OUT_MIRROR(width, height);
+    Image<ushort> OUT_MIRROR_101(width, height);
+    Image<ushort> OUT_CONST(width, height);
+
+    // filter mask
+    Mask<uchar> M(mask);
+
+    IN = host_in;
+
+    BoundaryCondition<uchar> BcInClamp(IN, M, Boundary::CLAMP);
+    Accessor<uchar> AccInClamp(BcInClamp);
+    IterationSpace<ushort> IsOutClamp(OUT_CLAMP);
+    WeightedSum WClamp(IsOutClamp, AccInClamp, M);
+
+    BoundaryCondition<uchar> BcInMirror(IN, M, Boundary::MIRROR);
+    Accessor<uchar> AccInMirror(BcInMirror);
+    IterationSpace<ushort> IsOutMirror(OUT_MIRROR);
+    WeightedSum WMirror(IsOutMirror, AccInMirror, M);
+
+    BoundaryCondition<uchar> BcInMirror101(IN, M, Boundary::MIRROR_101);
+    Accessor<uchar> AccInMirror101(BcInMirror101);
+    IterationSpace<ushort> IsOutMirror101(OUT_MIRROR_101);
+    WeightedSum WMirror101(IsOutMirror101, AccInMirror101, M);
+
+    BoundaryCondition<uchar> BcInConst(IN, M, Boundary::CONSTANT, 42);
+    Accessor<uchar> AccInConst(BcInConst);
+    IterationSpace<ushort> IsOutConst(OUT_CONST);
+    WeightedSum WConst(IsOutConst, AccInConst, M);
+
+    WClamp.execute();
+    WMirror.execute();
+    WMirror101.execute();
+    WConst.execute();
+
+    // compare results
+    const RefBorder modes[] = { REF_CLAMP, REF_MIRROR, REF_MIRROR_101,
+                                REF_CONSTANT };
+    ushort *outputs[] = { OUT_CLAMP.data(), OUT_MIRROR.data(),
+                          OUT_MIRROR_101.data(), OUT_CONST.data() };
+    int errors = 0;
+    for (int m = 0; m < 4; ++m) {
+        weighted_sum(host_in, ref_out, (const uchar *)mask, modes[m], 42,
+                     width, height);
+        for (int i = 0; i < width*height; ++i) {
+            if (outputs[m][i] != ref_out[i]) {
+                if (errors++ < 10) {
+                    fprintf(stderr, "Mismatch for border %d at (%d,%d): %d vs. %d\n",
+                            m, i%width, i/width, outputs[m][i], ref_out[i]);
+                }
+            }
+        }
+    }
+
+    // memory cleanup
+    free(host_in);
+    free(ref_out);
+
+    if (errors) {
+        fprintf(stderr, "Test FAILED: %d mismatches\n", errors);
+        return EXIT_FAILURE;
+    }
+    fprintf(stdout, "Test PASSED\n");
+    return EXIT_SUCCESS;
+}
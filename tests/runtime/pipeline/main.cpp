@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2014, Saarland University
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+// Streams frames through a two-stage HipaccPipeline and compares the results
+// to sequential runs of both stages.
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "hipacc_pipeline.hpp"
+
+#ifndef WIDTH
+#define WIDTH 512
+#endif
+#ifndef HEIGHT
+#define HEIGHT 512
+#endif
+#ifndef FRAMES
+#define FRAMES 32
+#endif
+#ifndef DEPTH
+#define DEPTH 3
+#endif
+
+
+struct Frame {
+    std::vector<int> in, out;
+};
+
+// intermediate image of a frame
+struct Intermediates {
+    std::vector<int> blur;
+
+    Intermediates(int width, int height) : blur(width*height) {}
+};
+
+
+// horizontal 3x1 box blur with clamped border
+void blur(const std::vector<int> &in, std::vector<int> &out) {
+    for (int y=0; y<HEIGHT; ++y) {
+        for (int x=0; x<WIDTH; ++x) {
+            int l = x > 0 ? x-1 : x;
+            int r = x < WIDTH-1 ? x+1 : x;
+            out[y*WIDTH + x] = (in[y*WIDTH + l] + in[y*WIDTH + x] +
+                                in[y*WIDTH + r]) / 3;
+        }
+    }
+}
+
+// binary threshold
+void threshold(const std::vector<int> &in, std::vector<int> &out) {
+    for (size_t i=0; i<in.size(); ++i)
+        out[i] = in[i] > 127 ? 255 : 0;
+}
+
+
+int main(int argc, const char **argv) {
+    std::vector<Frame> frames(FRAMES), reference(FRAMES);
+    for (int t=0; t<FRAMES; ++t) {
+        frames[t].in.resize(WIDTH*HEIGHT);
+        frames[t].out.resize(WIDTH*HEIGHT);
+        for (int i=0; i<WIDTH*HEIGHT; ++i)
+            frames[t].in[i] = (i*7 + t*13 + (i/WIDTH)*t) % 256;
+        reference[t] = frames[t];
+    }
+
+    // sequential runs
+    std::vector<int> tmp(WIDTH*HEIGHT);
+    for (int t=0; t<FRAMES; ++t) {
+        blur(reference[t].in, tmp);
+        threshold(tmp, reference[t].out);
+    }
+
+    // pipelined runs
+    {
+        HipaccPipeline<Frame *, Intermediates> pipeline({
+            [] (Frame *&frame, Intermediates &buffers) {
+                blur(frame->in, buffers.blur);
+            },
+            [] (Frame *&frame, Intermediates &buffers) {
+                threshold(buffers.blur, frame->out);
+            }
+        }, DEPTH, WIDTH, HEIGHT);
+
+        Frame *frame;
+        if (pipeline.pop(frame)) {
+            std::cerr << "Popped frame from empty pipeline" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        int popped = 0;
+        for (int t=0; t<FRAMES; ++t) {
+            // keep the pipeline full and pop the oldest frame
+            if (t >= DEPTH) {
+                if (!pipeline.pop(frame) || frame != &frames[popped++]) {
+                    std::cerr << "Frames popped out of order" << std::endl;
+                    return EXIT_FAILURE;
+                }
+            }
+            pipeline.push(&frames[t]);
+        }
+        while (pipeline.pop(frame)) {
+            if (frame != &frames[popped++]) {
+                std::cerr << "Frames popped out of order" << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+        if (popped != FRAMES) {
+            std::cerr << "Popped " << popped << " of " << FRAMES << " frames"
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "Pipeline: " << FRAMES << " frames, "
+                  << pipeline.getFPS() << " fps" << std::endl;
+    }
+
+    for (int t=0; t<FRAMES; ++t) {
+        for (int i=0; i<WIDTH*HEIGHT; ++i) {
+            if (frames[t].out[i] != reference[t].out[i]) {
+                std::cerr << "Test FAILED, at frame " << t << ", pixel " << i
+                          << ": " << frames[t].out[i] << " vs. "
+                          << reference[t].out[i] << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    std::cout << "Test PASSED" << std::endl;
+
+    return EXIT_SUCCESS;
+}
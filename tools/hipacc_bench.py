@@ -0,0 +1,313 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2014, Saarland University
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+#    list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+# ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+# ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+# ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+
+# Benchmark of the Hipacc samples: each sample is compiled by an installed
+# Hipacc for each image size and backend, run several times after warm-up
+# runs, and the median of the kernel timings printed by the sample
+# ("Hipacc: <ms> ms, ...") is reported as JSON and CSV. Results can be
+# compared against a baseline written by an earlier run.
+#
+#   hipacc_bench.py --prefix /opt/hipacc --samples samples --output bench \
+#                   --sizes 512x512,4096x4096 --baseline baseline.json
+
+import argparse
+import csv
+import glob
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import time
+
+
+# size in bytes of the pixel types of the DSL
+TYPE_SIZES = {
+    'char': 1, 'uchar': 1, 'short': 2, 'ushort': 2, 'int': 4, 'uint': 4,
+    'float': 4, 'double': 8,
+}
+
+
+def pixel_size(type_str):
+    match = re.match(r'(?:unsigned\s+)?([a-z]+?)(\d*)$', type_str.strip())
+    if not match or match.group(1) not in TYPE_SIZES:
+        return 0
+    lanes = int(match.group(2)) if match.group(2) else 1
+    return TYPE_SIZES[match.group(1)] * lanes
+
+
+def image_bytes_per_pixel(source):
+    # sum of the pixel sizes of all images allocated by the generated host code
+    with open(source) as f:
+        code = f.read()
+    return sum(pixel_size(t) for t in
+               re.findall(r'hipaccCreateMemory<\s*([\w ]+?)\s*>', code))
+
+
+def run(cmd, cwd, log, timeout=None, env=None):
+    with open(log, 'a') as f:
+        f.write('$ ' + ' '.join(cmd) + '\n')
+        f.flush()
+        try:
+            proc = subprocess.run(cmd, cwd=cwd, stdout=subprocess.PIPE,
+                                  stderr=subprocess.STDOUT,
+                                  universal_newlines=True, timeout=timeout,
+                                  env=env)
+        except subprocess.TimeoutExpired:
+            f.write('timeout after %d s\n' % timeout)
+            return None
+        f.write(proc.stdout)
+    return proc.stdout if proc.returncode == 0 else None
+
+
+def median(values):
+    values = sorted(values)
+    return values[len(values)//2]
+
+
+def build_cpu(args, sample, work, defines, log):
+    hipacc = os.path.join(args.prefix, 'bin', 'hipacc')
+    common = os.path.join(args.samples, 'common')
+    include = os.path.join(args.prefix, 'include')
+    cmd = [hipacc, '-emit-cpu', '-std=c++11', '-nostdinc++',
+           '-I', common, '-I', os.path.join(include, 'dsl'), '-I', include,
+           '-I', os.path.join(include, 'c++', 'v1'),
+           '-I', os.path.join(include, 'clang')] + defines + \
+          args.hipacc_flags.split() + \
+          [os.path.join(sample, 'src', 'main.cpp'), '-o', 'main_cpu.cc']
+    if run(cmd, work, log) is None:
+        return None
+
+    cmd = [args.cxx, '-std=c++11', '-O2', '-march=native', '-pthread',
+           '-fopenmp-simd'] + defines + args.cxx_flags.split() + \
+          ['main_cpu.cc', '-I', common, '-I', include,
+           '-L', os.path.join(args.prefix, 'lib'), '-lhipaccRuntime',
+           '-o', 'main_cpu']
+    if run(cmd, work, log) is None:
+        return None
+
+    return (['./main_cpu'], os.path.join(work, 'main_cpu.cc'), None)
+
+
+def build_vivado(args, sample, work, defines, log):
+    hipacc = os.path.join(args.prefix, 'bin', 'hipacc')
+    common = os.path.join(args.samples, 'common')
+    include = os.path.join(args.prefix, 'include')
+    cmd = [hipacc, '-emit-vivado', '-std=c++11', '-nostdinc++',
+           '-I', common, '-I', os.path.join(include, 'dsl'), '-I', include,
+           '-I', os.path.join(include, 'c++', 'v1'),
+           '-I', os.path.join(include, 'clang')] + defines + \
+          [os.path.join(sample, 'src', 'main.cpp'), '-o', 'main_vivado.cc']
+    if run(cmd, work, log) is None:
+        return None
+
+    # C simulation only, synthesis is not part of the benchmark
+    shutil.copy(os.path.join(common, 'directives.tcl'), work)
+    with open(os.path.join(common, 'script.tcl')) as f:
+        script = f.read()
+    script = script[:script.index('config_bind')] + 'exit\n'
+    with open(os.path.join(work, 'csim.tcl'), 'w') as f:
+        f.write(script)
+
+    env = dict(os.environ)
+    env['CPLUS_INCLUDE_PATH'] = os.pathsep.join(
+        p for p in [env.get('CPLUS_INCLUDE_PATH'), common, include] if p)
+
+    return (['vivado_hls', '-f', 'csim.tcl'],
+            os.path.join(work, 'main_vivado.cc'), env)
+
+
+BACKENDS = {'cpu': build_cpu, 'vivado': build_vivado}
+
+
+def bench(args, sample, backend, width, height):
+    name = os.path.relpath(sample, args.samples)
+    result = {'sample': name, 'backend': backend, 'width': width,
+              'height': height, 'ms': None, 'min_ms': None, 'max_ms': None,
+              'mpix_s': None, 'bytes_per_pixel': None, 'status': 'ok'}
+
+    work = os.path.join(args.output, backend, name.replace(os.sep, '_'),
+                        '%dx%d' % (width, height))
+    os.makedirs(work, exist_ok=True)
+    log = os.path.join(work, 'bench.log')
+    if os.path.exists(log):
+        os.remove(log)
+    defines = ['-DWIDTH=%d' % width, '-DHEIGHT=%d' % height]
+
+    built = BACKENDS[backend](args, sample, work, defines, log)
+    if built is None:
+        result['status'] = 'build failed'
+        return result
+    cmd, source, env = built
+    result['bytes_per_pixel'] = image_bytes_per_pixel(source)
+
+    times = []
+    for i in range(args.warmup + args.repeat):
+        start = time.time()
+        output = run(cmd, work, log, args.timeout, env)
+        wall = (time.time() - start) * 1000.0
+        if output is None:
+            result['status'] = 'run failed'
+            return result
+        if i < args.warmup:
+            continue
+        # kernel timing printed by the sample, the whole C simulation else
+        match = re.search(r'Hipacc: ([0-9.eE+-]+) ms', output)
+        if backend == 'vivado':
+            times.append(wall)
+        elif match:
+            times.append(float(match.group(1)))
+        else:
+            result['status'] = 'no timing'
+            return result
+
+    result['ms'] = median(times)
+    result['min_ms'] = min(times)
+    result['max_ms'] = max(times)
+    if result['ms'] > 0:
+        result['mpix_s'] = width*height / result['ms'] / 1000.0
+    return result
+
+
+def compare(results, baseline_file, threshold):
+    with open(baseline_file) as f:
+        baseline = json.load(f)
+    reference = {(r['sample'], r['backend'], r['width'], r['height']): r
+                 for r in baseline['results']}
+
+    regressions = 0
+    for r in results:
+        key = (r['sample'], r['backend'], r['width'], r['height'])
+        if r['ms'] is None or key not in reference or \
+           reference[key]['ms'] is None:
+            continue
+        ratio = r['ms'] / reference[key]['ms']
+        if ratio > 1.0 + threshold:
+            regressions += 1
+            print('REGRESSION: %s (%s, %dx%d): %.4f ms vs. %.4f ms (%+.1f%%)'
+                  % (r['sample'], r['backend'], r['width'], r['height'],
+                     r['ms'], reference[key]['ms'], (ratio - 1.0) * 100.0))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Benchmark Hipacc samples')
+    parser.add_argument('--prefix', required=True,
+                        help='installation prefix of Hipacc')
+    parser.add_argument('--samples', required=True,
+                        help='samples directory')
+    parser.add_argument('--output', default='bench',
+                        help='directory for builds and results')
+    parser.add_argument('--backends', default='cpu',
+                        help='comma separated list of: ' +
+                        ', '.join(sorted(BACKENDS)))
+    parser.add_argument('--sizes',
+                        default='512x512,1024x1024,2048x2048,4096x4096,8192x8192',
+                        help='comma separated list of image sizes <w>x<h>')
+    parser.add_argument('--filter', default='',
+                        help='only run samples matching this regex')
+    parser.add_argument('--warmup', type=int, default=1,
+                        help='runs before timing')
+    parser.add_argument('--repeat', type=int, default=5,
+                        help='timed runs, the median is reported')
+    parser.add_argument('--timeout', type=int, default=600,
+                        help='timeout per run in seconds')
+    parser.add_argument('--cxx', default=os.environ.get('CXX', 'c++'),
+                        help='C++ compiler')
+    parser.add_argument('--cxx-flags', default='',
+                        help='additional flags for the C++ compiler')
+    parser.add_argument('--hipacc-flags', default='',
+                        help='additional flags for Hipacc, e.g. "-cpu-threads auto"')
+    parser.add_argument('--baseline', default='',
+                        help='results of an earlier run to compare against')
+    parser.add_argument('--threshold', type=float, default=0.1,
+                        help='relative slowdown reported as regression')
+    args = parser.parse_args()
+
+    args.prefix = os.path.abspath(args.prefix)
+    args.samples = os.path.abspath(args.samples)
+    args.output = os.path.abspath(args.output)
+
+    backends = [b for b in args.backends.split(',') if b]
+    for backend in backends:
+        if backend not in BACKENDS:
+            parser.error('unknown backend: ' + backend)
+    if 'vivado' in backends and shutil.which('vivado_hls') is None:
+        print('Warning: could not find binary \'vivado_hls\' in PATH, '
+              'skipping Vivado C simulation')
+        backends.remove('vivado')
+
+    sizes = []
+    for size in args.sizes.split(','):
+        match = re.match(r'(\d+)x(\d+)$', size)
+        if not match:
+            parser.error('invalid image size: ' + size)
+        sizes.append((int(match.group(1)), int(match.group(2))))
+
+    samples = sorted(d for d in glob.glob(os.path.join(args.samples, '[0-9]*', '*'))
+                     if os.path.isfile(os.path.join(d, 'src', 'main.cpp')) and
+                     re.search(args.filter, d))
+
+    results = []
+    for backend in backends:
+        for sample in samples:
+            for width, height in sizes:
+                r = bench(args, sample, backend, width, height)
+                results.append(r)
+                if r['ms'] is None:
+                    print('%-45s %-6s %5dx%-5d %s' % (r['sample'], backend,
+                          width, height, r['status']))
+                else:
+                    print('%-45s %-6s %5dx%-5d %10.4f ms %10.2f Mpixel/s %3d bytes/pixel'
+                          % (r['sample'], backend, width, height, r['ms'],
+                             r['mpix_s'] or 0.0, r['bytes_per_pixel']))
+                sys.stdout.flush()
+
+    os.makedirs(args.output, exist_ok=True)
+    with open(os.path.join(args.output, 'results.json'), 'w') as f:
+        json.dump({'warmup': args.warmup, 'repeat': args.repeat,
+                   'results': results}, f, indent=2)
+    with open(os.path.join(args.output, 'results.csv'), 'w') as f:
+        writer = csv.DictWriter(f, fieldnames=list(results[0].keys()) if
+                                results else ['sample'])
+        writer.writeheader()
+        writer.writerows(results)
+    print('Results written to ' + os.path.join(args.output, 'results.{json,csv}'))
+
+    if args.baseline:
+        regressions = compare(results, args.baseline, args.threshold)
+        if regressions:
+            print('%d regression(s) above %.0f%%' % (regressions,
+                  args.threshold * 100.0))
+            return 1
+        print('No regressions above %.0f%%' % (args.threshold * 100.0))
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())